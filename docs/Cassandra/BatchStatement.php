@@ -37,7 +37,7 @@ namespace Cassandra;
  * @see Cassandra::BATCH_UNLOGGED
  * @see Cassandra::BATCH_COUNTER
  */
-final class BatchStatement implements Statement {
+final class BatchStatement implements Statement, \Countable {
 
     /**
      * Creates a new batch statement.
@@ -47,7 +47,8 @@ final class BatchStatement implements Statement {
     public function __construct($type) { }
 
     /**
-     * Adds a statement to this batch.
+     * Adds a statement to this batch. The statement is bound when it is
+     * added, so a batch can be executed repeatedly without being rebuilt.
      *
      * @param string|\Cassandra\Statement $statement string or statement to add
      * @param array|null $arguments positional or named arguments (optional)
@@ -58,4 +59,11 @@ final class BatchStatement implements Statement {
      */
     public function add($statement, $arguments) { }
 
+    /**
+     * Returns the number of statements in this batch.
+     *
+     * @return int number of statements
+     */
+    public function count() { }
+
 }
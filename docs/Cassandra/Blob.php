@@ -20,6 +20,10 @@ namespace Cassandra;
 
 /**
  * A PHP representation of the CQL `blob` datatype
+ *
+ * Blobs of 4 KiB or more read from a result reference its buffer instead of
+ * copying it, which keeps the whole result page alive as long as the blob.
+ * Use the `native_scalars` execution option to read large blobs as strings.
  */
 final class Blob implements Value {
 
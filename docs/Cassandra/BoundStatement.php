@@ -0,0 +1,46 @@
+<?php
+
+/**
+ * Copyright 2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * A prepared statement together with its bound arguments and execution
+ * options. Executing it again reuses the same driver statement, rebinding only
+ * the values that changed.
+ *
+ * Options given to `PreparedStatement::bind()` take precedence over the ones
+ * given at execution. Arguments can't be given at execution, they are only
+ * given to `bind()`.
+ *
+ * @see PreparedStatement::bind()
+ */
+final class BoundStatement implements Statement {
+
+    private function __construct() { }
+
+    /**
+     * Overwrites the bound arguments. Parameters that are not given keep
+     * their previous value.
+     *
+     * @param array $arguments Arguments to bind
+     *
+     * @return \Cassandra\BoundStatement This statement
+     */
+    public function bind($arguments) { }
+
+}
@@ -292,6 +292,38 @@ final class Builder {
      */
     public function withRetryPolicy($policy) { }
 
+    /**
+     * Adds a named execution profile. Profiles are validated once and
+     * selected per request with the `execution_profile` execution option.
+     *
+     * Only the `consistency`, `serial_consistency`, `timeout` (request
+     * timeout) and `retry_policy` options are supported by profiles.
+     *
+     * @param string $name the name used to select the profile.
+     * @param array|\Cassandra\ExecutionOptions $options options of the profile.
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\Cluster\Builder self
+     */
+    public function withExecutionProfile($name, $options) { }
+
+    /**
+     * Sets statements prepared as soon as a persistent session connects.
+     *
+     * The statements are prepared concurrently once per process and kept in
+     * the prepared statement cache, so the first requests served don't wait
+     * for them. Preparing shares the connect timeout, failures don't prevent
+     * connecting and are reported by `Session::warmupStatus()`.
+     *
+     * @param array $statements the CQL of the statements to prepare.
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\Cluster\Builder self
+     */
+    public function withWarmup($statements) { }
+
     /**
      * Sets the timestamp generator.
      *
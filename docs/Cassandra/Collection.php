@@ -30,6 +30,19 @@ final class Collection implements Value, \Countable, \Iterator {
      */
     public function __construct($type) { }
 
+    /**
+     * Creates a collection from the values of an array, validating them once
+     * for the whole array. Keys of the array are discarded.
+     *
+     * @param \Cassandra\Type|string $type   Type of the values
+     * @param array                  $values Values of the collection
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\Collection
+     */
+    public static function fromArray($type, array $values) { }
+
     /**
      * The type of this collection.
      *
@@ -0,0 +1,67 @@
+<?php
+
+/**
+ * Copyright 2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+namespace Cassandra;
+
+/**
+ * Waits on many futures at once under a single deadline. Futures are resolved
+ * as they complete rather than in the order they were given.
+ */
+final class Futures {
+
+    /**
+     * Waits for all futures to resolve and throws the first error encountered.
+     *
+     * @param Future[] $futures Futures to wait for
+     * @param int|double|null $timeout A timeout in seconds for the whole set
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return array Results keyed and ordered like the given futures
+     */
+    public static function all($futures, $timeout = null) { }
+
+    /**
+     * Waits for the first future to resolve successfully. When every future
+     * fails, the last error is thrown.
+     *
+     * @param Future[] $futures Futures to wait for
+     * @param int|double|null $timeout A timeout in seconds for the whole set
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return mixed Result of the first future to succeed
+     */
+    public static function any($futures, $timeout = null) { }
+
+    /**
+     * Waits for all futures to either resolve or fail.
+     *
+     * @param Future[] $futures Futures to wait for
+     * @param int|double|null $timeout A timeout in seconds for the whole set
+     *
+     * @throws Exception\InvalidArgumentException
+     * @throws Exception\TimeoutException
+     *
+     * @return array Results or exceptions keyed like the given futures, in completion order
+     */
+    public static function settled($futures, $timeout = null) { }
+
+}
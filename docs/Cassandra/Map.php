@@ -31,6 +31,35 @@ final class Map implements Value, \Countable, \Iterator, \ArrayAccess {
      */
     public function __construct($keyType, $valueType) { }
 
+    /**
+     * Creates a map pairing the elements of two arrays in order. A key given
+     * more than once keeps its last value.
+     *
+     * @param \Cassandra\Type|string $keyType   Type of the keys
+     * @param \Cassandra\Type|string $valueType Type of the values
+     * @param array                  $keys      Keys of the map
+     * @param array                  $values    Values of the map, as many as keys
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\Map
+     */
+    public static function fromArrays($keyType, $valueType, array $keys, array $values) { }
+
+    /**
+     * Creates a map from the keys and values of an array. Integer keys are
+     * converted to strings when the key type is `text`, `varchar` or `ascii`.
+     *
+     * @param \Cassandra\Type|string $keyType   Type of the keys
+     * @param \Cassandra\Type|string $valueType Type of the values
+     * @param array                  $values    Values of the map indexed by their keys
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\Map
+     */
+    public static function fromAssoc($keyType, $valueType, array $values) { }
+
     /**
      * The type of this map.
      *
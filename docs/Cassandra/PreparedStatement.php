@@ -26,10 +26,28 @@ namespace Cassandra;
  * faster, because they are sent directly to replica nodes and avoid the extra
  * network hop.
  *
+ * Arguments are bound using the parameter types returned by the server, so
+ * plain PHP values can be used where a value object would otherwise be
+ * needed: integers for `bigint`, `smallint`, `tinyint`, `timestamp` and
+ * `time` columns, floats for `float` columns and strings for `uuid`,
+ * `timeuuid`, `inet` and `blob` columns.
+ *
  * @see Session::prepare()
  */
 final class PreparedStatement implements Statement {
 
     private function __construct() { }
 
+    /**
+     * Creates a reusable statement bound to the given arguments. The driver
+     * statement and the execution options are kept between executions.
+     *
+     * @param array|null $arguments Arguments to bind
+     * @param array|\Cassandra\ExecutionOptions|null $options Consistency, serial consistency, page size,
+     *                                                        retry policy and timestamp to apply once
+     *
+     * @return \Cassandra\BoundStatement A statement that can be executed repeatedly
+     */
+    public function bind($arguments = null, $options = null) { }
+
 }
@@ -30,6 +30,9 @@ final class Rows implements \Iterator, \ArrayAccess {
     /**
      * Returns the number of rows.
      *
+     * For streamed rows (see `Session::executeStream()`) this is the number of
+     * rows in the page currently being iterated, not in the whole result.
+     *
      * @return int number of rows
      *
      * @see \Countable::count()
@@ -57,6 +60,8 @@ final class Rows implements \Iterator, \ArrayAccess {
     /**
      * Returns current index.
      *
+     * For streamed rows the index keeps counting across pages.
+     *
      * @return int index
      *
      * @see \Iterator::key()
@@ -86,6 +91,8 @@ final class Rows implements \Iterator, \ArrayAccess {
      *
      * @param int $offset row index
      *
+     * @throws Exception\LogicException when the rows are streamed
+     *
      * @return bool whether a row at a given index exists
      *
      * @see \ArrayAccess::offsetExists()
@@ -97,6 +104,8 @@ final class Rows implements \Iterator, \ArrayAccess {
      *
      * @param int $offset row index
      *
+     * @throws Exception\LogicException when the rows are streamed
+     *
      * @return array|null row at a given index
      *
      * @see \ArrayAccess::offsetGet()
@@ -163,8 +172,34 @@ final class Rows implements \Iterator, \ArrayAccess {
     /**
      * Get the first row.
      *
+     * For streamed rows this is the first row of the current page.
+     *
      * @return array|null returns first row if any
      */
     public function first() { }
 
+    /**
+     * Returns the values of a single column of this page, decoded directly from
+     * the result without building row arrays.
+     *
+     * @param string|int $column column name or index
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException when the column doesn't exist
+     *
+     * @return array values of the column, in row order
+     */
+    public function fetchColumn($column) { }
+
+    /**
+     * Returns the columns of this page as arrays of values keyed by column name.
+     * Columns that are not requested are never decoded.
+     *
+     * @param array|null $columns column names or indexes, all columns when null
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException when a column doesn't exist
+     *
+     * @return array values of each column, in row order
+     */
+    public function toColumns($columns = null) { }
+
 }
@@ -40,6 +40,9 @@ interface Session {
      * | serial_consistency | int             | Either Dse::CONSISTENCY_SERIAL or Dse::CONSISTENCY_LOCAL_SERIAL                                          |
      * | timestamp          | int\|string     | Either an integer or integer string timestamp that represents the number of microseconds since the epoch |
      * | execute_as         | string          | User to execute statement as                                                                             |
+     * | native_scalars     | bool            | Return blob and uuid columns as strings and bigint, counter and timestamp columns as integers            |
+     * | native_integers    | bool            | Return bigint, counter, smallint, tinyint and timestamp (milliseconds) columns as integers               |
+     * | execution_profile  | string          | Name of an execution profile added with Cluster\Builder::withExecutionProfile()                          |
      *
      * @param string|\Cassandra\Statement $statement string or statement to be executed.
      * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the query.
@@ -63,6 +66,72 @@ interface Session {
      */
     public function executeAsync($statement, $options);
 
+    /**
+     * Execute a query and stream every page of its result. Iterating the
+     * returned rows walks all pages: the next page is requested as soon as the
+     * current one arrives and each page is released once it has been consumed.
+     * Blobs of 4 KiB or more that are kept keep their page alive, use the
+     * `native_scalars` option to read them as strings. Streamed rows can only
+     * be iterated once.
+     *
+     * @param string|\Cassandra\Statement $statement string or statement to be executed.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the query.
+     *
+     * @throws Exception
+     *
+     * @return \Cassandra\Rows Rows positioned on the first page.
+     *
+     * @see Session::execute() for valid execution options
+     */
+    public function executeStream($statement, $options);
+
+    /**
+     * Execute a statement once for each row of arguments, keeping at most
+     * `$concurrency` requests in flight. Requests are refilled from the
+     * arguments as earlier ones complete. The `timeout` option bounds the
+     * whole call, requests still in flight once it expires are abandoned.
+     *
+     * @param string|\Cassandra\SimpleStatement|\Cassandra\PreparedStatement $statement statement to be executed.
+     * @param array|\Traversable $arguments Arguments of each execution, keyed by row.
+     * @param int $concurrency Maximum number of requests in flight, capped at 4096.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the query.
+     *
+     * @throws Exception
+     * @throws Exception\TimeoutException
+     *
+     * @return array The `success` and `failure` counts and the `errors` of failed rows keyed like `$arguments`.
+     *
+     * @see Session::execute() for valid execution options
+     */
+    public function executeConcurrent($statement, $arguments, $concurrency = 100, $options = null);
+
+    /**
+     * Execute a prepared statement for each row of arguments, grouping rows
+     * that share a partition key into unlogged batches of at most
+     * `$batchSize` statements. Batches stay single-partition, so token-aware
+     * routing sends each one to a replica of its partition, and at most
+     * `$concurrency` batches are in flight at once. The `timeout` option
+     * bounds the whole call, batches still in flight once it expires are
+     * abandoned.
+     *
+     * @param \Cassandra\PreparedStatement $statement statement to be executed.
+     * @param array|\Traversable $rows Arguments of each execution, keyed by row.
+     * @param array|\Cassandra\Table $partitionKey Names or positions of the partition key arguments,
+     *                                           or the table whose partition key columns name them.
+     * @param int $batchSize Maximum number of statements in a batch.
+     * @param int $concurrency Maximum number of batches in flight, capped at 4096.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control execution of the batches.
+     *
+     * @throws Exception
+     * @throws Exception\TimeoutException
+     *
+     * @return array The `success` and `failure` row counts, the number of `batches` sent and the
+     *               `errors` of failed rows keyed like `$rows`.
+     *
+     * @see Session::execute() for valid execution options
+     */
+    public function executeGrouped($statement, $rows, $partitionKey, $batchSize = 100, $concurrency = 100, $options = null);
+
     /**
      * Prepare a query for execution.
      *
@@ -83,12 +152,32 @@ interface Session {
      * @param string $cql The query to be prepared.
      * @param array|\Cassandra\ExecutionOptions|null $options Options to control preparing the query.
      *
+     * Statements already prepared by a persistent session are returned by a
+     * resolved future.
+     *
      * @return \Cassandra\FuturePreparedStatement A future that can be used to retrieve the prepared statement.
      *
      * @see Session::execute() for valid execution options
      */
     public function prepareAsync($cql, $options);
 
+    /**
+     * Prepare many queries at once, waiting for all of them together.
+     *
+     * Queries missing from the prepared statement cache are sent concurrently.
+     * The timeout option bounds the whole call.
+     *
+     * @param array $cqls The queries to be prepared.
+     * @param array|\Cassandra\ExecutionOptions|null $options Options to control preparing the queries.
+     *
+     * @throws Exception
+     *
+     * @return array Prepared statements under the keys of the given queries.
+     *
+     * @see Session::execute() for valid execution options
+     */
+    public function prepareAll($cqls, $options = null);
+
     /**
      * Close the session and all its connections.
      *
@@ -110,9 +199,43 @@ interface Session {
     /**
      * Get performance and diagnostic metrics.
      *
+     * Metrics are grouped in sections:
+     *
+     * * `stats` - connections of the session
+     * * `requests` - latency histogram in microseconds and rates of the
+     *   session's requests, `in_flight` counts the requests sent through
+     *   this session object, including next pages, that haven't completed yet
+     * * `errors` - timeouts of the session
+     * * `speculative_executions` - histogram, count and percentage of the
+     *   speculative executions of the session
+     * * `prepared_cache` - size, capacity, hits, misses and evictions of the
+     *   prepared statement cache of the process
+     *
+     * The underlying driver doesn't expose metrics per host.
+     *
+     * @param bool $flat Whether to join section and metric names with an
+     *                   underscore into a single level array, e.g. `requests_p99`.
+     *
      * @return array Performance/Diagnostic metrics.
      */
-    public function metrics();
+    public function metrics($flat = false);
+
+    /**
+     * Get the state of the warm-up configured with `Cluster\Builder::withWarmup()`.
+     *
+     * Keys of the returned array:
+     *
+     * * `complete` - whether the warm-up of this process has finished, false
+     *   when no statements were configured
+     * * `statements` - number of statements to prepare
+     * * `prepared` - number of statements kept in the prepared statement cache
+     * * `failed` - number of statements that failed to prepare or were still
+     *   preparing when the connect timeout expired
+     * * `duration` - seconds spent preparing the statements
+     *
+     * @return array Warm-up state of the session.
+     */
+    public function warmupStatus();
 
     /**
      * Get a snapshot of the cluster's current schema.
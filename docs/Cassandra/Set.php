@@ -30,6 +30,19 @@ final class Set implements Value, \Countable, \Iterator {
      */
     public function __construct($type) { }
 
+    /**
+     * Creates a set from the values of an array, validating them once for the
+     * whole array. Duplicate values are only added once.
+     *
+     * @param \Cassandra\Type|string $type   Type of the values
+     * @param array                  $values Values of the set
+     *
+     * @throws \Cassandra\Exception\InvalidArgumentException
+     *
+     * @return \Cassandra\Set
+     */
+    public static function fromArray($type, array $values) { }
+
     /**
      * The type of this set.
      *
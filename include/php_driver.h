@@ -204,6 +204,7 @@ typedef unsigned long ulong;
     PHP_MINFO_FUNCTION(php_driver);
     PHP_INI_MH(OnUpdateLogLevel);
     PHP_INI_MH(OnUpdateLog);
+    PHP_INI_MH(OnUpdatePreparedCacheSize);
 
     zend_class_entry *exception_class(CassError rc);
 
@@ -241,6 +242,7 @@ typedef unsigned long ulong;
 
 #define PHP_DRIVER_DEFAULT_LOG PHP_DRIVER_NAME ".log"
 #define PHP_DRIVER_DEFAULT_LOG_LEVEL "ERROR"
+#define PHP_DRIVER_DEFAULT_PREPARED_CACHE_SIZE "1000"
 
 
 #ifdef __cplusplus
@@ -7,7 +7,10 @@ ZEND_BEGIN_MODULE_GLOBALS(php_driver)
   pid_t         uuid_gen_pid;
   unsigned int  persistent_clusters;
   unsigned int  persistent_sessions;
-  unsigned int  persistent_prepared_statements;
+  struct php_driver_prepared_cache_ *prepared_cache;
+  struct php_driver_pending_release_ *pending_releases;
+  zend_long     prepared_cache_size;
+  HashTable    *type_cache;
   zval  type_varchar;
   zval  type_text;
   zval  type_blob;
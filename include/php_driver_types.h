@@ -108,6 +108,8 @@ typedef struct php_driver_blob_
 {
     cass_byte_t *data;
     size_t size;
+    /* Owner of `data` when it is borrowed from a result, NULL when `data` is allocated */
+    struct php_driver_ref_ *ref;
     zend_object zendObject;
 } php_driver_blob;
 static zend_always_inline php_driver_blob *php_driver_blob_object_fetch(zend_object *obj)
@@ -153,6 +155,9 @@ typedef struct php_driver_collection_
     HashTable values;
     unsigned hashv;
     int dirty;
+    zend_bool hash_nested;
+    zend_ulong hash_version;
+    zend_ulong version;
     zend_object zendObject;
 } php_driver_collection;
 static zend_always_inline php_driver_collection *php_driver_collection_object_fetch(zend_object *obj)
@@ -160,16 +165,36 @@ static zend_always_inline php_driver_collection *php_driver_collection_object_fe
     return (php_driver_collection *)((char *)obj - ((size_t)(&(((php_driver_collection *)0)->zendObject))));
 }
 
-typedef struct php_driver_map_entry_ php_driver_map_entry;
+typedef struct php_driver_flat_entry_
+{
+    zval key;
+    zval value;
+    uint32_t hash;
+} php_driver_flat_entry;
+
+/* Insertion ordered open-addressing table backing Cassandra\Map and
+ * Cassandra\Set. Entries are stored contiguously, removed entries keep their
+ * position with an undefined key until the table is compacted, and the index
+ * holds entry positions plus one (zero marks an empty slot) probed linearly. */
+typedef struct php_driver_flat_hash_
+{
+    php_driver_flat_entry *entries;
+    uint32_t *index;
+    uint32_t used;
+    uint32_t count;
+    uint32_t size;
+} php_driver_flat_hash;
 
 typedef struct php_driver_map_
 {
     zval type;
-    php_driver_map_entry *entries;
+    php_driver_flat_hash entries;
     unsigned hashv;
     int dirty;
-    php_driver_map_entry *iter_curr;
-    php_driver_map_entry *iter_temp;
+    zend_bool hash_nested;
+    zend_ulong hash_version;
+    zend_ulong version;
+    uint32_t iter_pos;
     zend_object zendObject;
 } php_driver_map;
 static zend_always_inline php_driver_map *php_driver_map_object_fetch(zend_object *obj)
@@ -177,16 +202,16 @@ static zend_always_inline php_driver_map *php_driver_map_object_fetch(zend_objec
     return (php_driver_map *)((char *)obj - ((size_t)(&(((php_driver_map *)0)->zendObject))));
 }
 
-typedef struct php_driver_set_entry_ php_driver_set_entry;
-
 typedef struct php_driver_set_
 {
     zval type;
-    php_driver_set_entry *entries;
+    php_driver_flat_hash entries;
     unsigned hashv;
     int dirty;
-    php_driver_set_entry *iter_curr;
-    php_driver_set_entry *iter_temp;
+    zend_bool hash_nested;
+    zend_ulong hash_version;
+    zend_ulong version;
+    uint32_t iter_pos;
     int iter_index;
     zend_object zendObject;
 } php_driver_set;
@@ -202,6 +227,9 @@ typedef struct php_driver_tuple_
     HashPosition pos;
     unsigned hashv;
     int dirty;
+    zend_bool hash_nested;
+    zend_ulong hash_version;
+    zend_ulong version;
     zend_object zendObject;
 } php_driver_tuple;
 static zend_always_inline php_driver_tuple *php_driver_tuple_object_fetch(zend_object *obj)
@@ -216,6 +244,9 @@ typedef struct php_driver_user_type_value_
     HashPosition pos;
     unsigned hashv;
     int dirty;
+    zend_bool hash_nested;
+    zend_ulong hash_version;
+    zend_ulong version;
     zend_object zendObject;
 } php_driver_user_type_value;
 static zend_always_inline php_driver_user_type_value *php_driver_user_type_value_object_fetch(zend_object *obj)
@@ -233,6 +264,7 @@ typedef struct php_driver_cluster_
     cass_bool_t persist;
     char *hash_key;
     int hash_key_len;
+    HashTable *warmup_statements;
     zend_object zendObject;
 } php_driver_cluster;
 static zend_always_inline php_driver_cluster *php_driver_cluster_object_fetch(zend_object *obj)
@@ -240,11 +272,25 @@ static zend_always_inline php_driver_cluster *php_driver_cluster_object_fetch(ze
     return (php_driver_cluster *)((char *)obj - offsetof(php_driver_cluster, zendObject));
 }
 
+typedef void (*php_driver_free_function)(void *data);
+
+typedef struct php_driver_ref_
+{
+    size_t count;
+    php_driver_free_function destruct;
+    void *data;
+} php_driver_ref;
+
+struct php_driver_bind_parameters_;
+struct php_driver_future_state_;
+struct php_driver_future_counter_;
+
 typedef enum
 {
     PHP_DRIVER_SIMPLE_STATEMENT,
     PHP_DRIVER_PREPARED_STATEMENT,
-    PHP_DRIVER_BATCH_STATEMENT
+    PHP_DRIVER_BATCH_STATEMENT,
+    PHP_DRIVER_BOUND_STATEMENT
 } php_driver_statement_type;
 
 typedef struct php_driver_statement_
@@ -258,12 +304,29 @@ typedef struct php_driver_statement_
         struct
         {
             const CassPrepared *prepared;
+            php_driver_ref *columns;
+            struct php_driver_bind_parameters_ *parameters;
         } prepared;
         struct
         {
             CassBatchType type;
             HashTable statements;
+            /* Statements are bound when added, rebuilt only while shared with a request */
+            php_driver_ref *batch;
         } batch;
+        struct
+        {
+            /* Reused across executions, rebuilt only while shared with a request */
+            php_driver_ref *statement;
+            zval prepared;
+            zval arguments;
+            long consistency;
+            long serial_consistency;
+            int page_size;
+            zval retry_policy;
+            cass_int64_t timestamp;
+            zend_string *execution_profile;
+        } bound;
     } data;
     zend_object zendObject;
 } php_driver_statement;
@@ -289,6 +352,8 @@ typedef struct php_driver_execution_options_
     zval arguments;
     zval retry_policy;
     cass_int64_t timestamp;
+    int native_options;
+    zend_string *execution_profile;
     zend_object zendObject;
 } php_driver_execution_options;
 static zend_always_inline php_driver_execution_options *php_driver_execution_options_object_fetch(zend_object *obj)
@@ -303,21 +368,25 @@ typedef enum /* : uint8_t */
     LOAD_BALANCING_DC_AWARE_ROUND_ROBIN
 } php_driver_load_balancing;
 
-typedef void (*php_driver_free_function)(void *data);
-
-typedef struct
-{
-    size_t count;
-    php_driver_free_function destruct;
-    void *data;
-} php_driver_ref;
-
 typedef struct php_driver_rows_
 {
     php_driver_ref *statement;
     php_driver_ref *session;
+    struct php_driver_future_counter_ *requests;
+    /* Result of the current page, rows are decoded on demand */
+    php_driver_ref *page;
+    php_driver_ref *columns;
+    CassIterator *iterator;
+    zend_long iterator_index;
+    zend_long count;
+    zend_long position;
+    zval row;
+    zend_long row_index;
+    /* Every row of the current page, decoded once rows are accessed backwards */
     zval rows;
-    zval next_rows;
+    /* Streamed rows walk every page, prefetching the next one */
+    zend_bool stream;
+    zend_long offset;
     php_driver_ref *result;
     php_driver_ref *next_result;
     zval future_next_page;
@@ -332,9 +401,12 @@ typedef struct php_driver_future_rows_
 {
     php_driver_ref *statement;
     php_driver_ref *session;
-    zval rows;
+    struct php_driver_future_counter_ *requests;
     php_driver_ref *result;
+    php_driver_ref *columns;
+    int native_options;
     CassFuture *future;
+    struct php_driver_future_state_ *state;
     zend_object zendObject;
 } php_driver_future_rows;
 static zend_always_inline php_driver_future_rows *php_driver_future_rows_object_fetch(zend_object *obj)
@@ -401,6 +473,8 @@ typedef struct php_driver_cluster_builder_
     php_driver_timestamp_gen *timestamp_gen;
     php_driver_ssl *ssl_options;
     zval default_timeout;
+    HashTable *execution_profiles;
+    HashTable *warmup_statements;
 
     zend_object zendObject;
 
@@ -413,7 +487,11 @@ static zend_always_inline php_driver_cluster_builder *php_driver_cluster_builder
 typedef struct php_driver_future_prepared_statement_
 {
     CassFuture *future;
+    struct php_driver_future_state_ *state;
     zval prepared_statement;
+    zend_string *cql;
+    zend_ulong hash;
+    zend_ulong scope;
     zend_object zendObject;
 } php_driver_future_prepared_statement;
 static zend_always_inline php_driver_future_prepared_statement *php_driver_future_prepared_statement_object_fetch(
@@ -455,6 +533,7 @@ typedef struct php_driver_future_session_
     CassError exception_code;
     char *session_keyspace;
     char *session_hash_key;
+    HashTable *warmup_statements;
     zend_object zendObject;
 } php_driver_future_session;
 static zend_always_inline php_driver_future_session *php_driver_future_session_object_fetch(zend_object *obj)
@@ -464,23 +543,31 @@ static zend_always_inline php_driver_future_session *php_driver_future_session_o
 
 typedef struct
 {
-    CassFuture *future;
-    php_driver_ref *session;
-} php_driver_psession;
+    uint32_t statements;
+    uint32_t prepared;
+    uint32_t failed;
+    double duration;
+    cass_bool_t complete;
+} php_driver_warmup;
 
 typedef struct
 {
     CassFuture *future;
-    php_driver_ref *ref;
-} php_driver_pprepared_statement;
+    php_driver_ref *session;
+    php_driver_warmup warmup;
+} php_driver_psession;
 
 typedef struct php_driver_session_
 {
     php_driver_ref *session;
+    /* Requests sent through this session that haven't completed */
+    struct php_driver_future_counter_ *requests;
     long default_consistency;
     int default_page_size;
     char *keyspace;
     char *hash_key;
+    zend_ulong prepared_scope;
+    php_driver_warmup warmup;
     zval default_timeout;
     cass_bool_t persist;
     zend_object zendObject;
@@ -760,6 +847,7 @@ extern PHP_SCYLLADB_API zend_class_entry *php_driver_future_rows_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_future_session_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_future_value_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_future_close_ce;
+extern PHP_SCYLLADB_API zend_class_entry *php_driver_futures_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_session_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_default_session_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_exception_ce;
@@ -793,6 +881,7 @@ extern PHP_SCYLLADB_API zend_class_entry *php_driver_statement_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_simple_statement_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_prepared_statement_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_batch_statement_ce;
+extern PHP_SCYLLADB_API zend_class_entry *php_driver_bound_statement_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_execution_options_ce;
 extern PHP_SCYLLADB_API zend_class_entry *php_driver_rows_ce;
 
@@ -803,6 +892,7 @@ void php_driver_define_FutureRows();
 void php_driver_define_FutureSession();
 void php_driver_define_FutureValue();
 void php_driver_define_FutureClose();
+void php_driver_define_Futures();
 void php_driver_define_Session();
 void php_driver_define_DefaultSession();
 void php_driver_define_SSLOptions();
@@ -811,6 +901,7 @@ void php_driver_define_Statement();
 void php_driver_define_SimpleStatement();
 void php_driver_define_PreparedStatement();
 void php_driver_define_BatchStatement();
+void php_driver_define_BoundStatement();
 void php_driver_define_ExecutionOptions();
 void php_driver_define_Rows();
 
@@ -888,5 +979,4 @@ void php_driver_define_TimestampGeneratorServerSide();
 
 extern int php_le_php_driver_cluster();
 extern int php_le_php_driver_session();
-extern int php_le_php_driver_prepared_statement();
 END_EXTERN_C()
\ No newline at end of file
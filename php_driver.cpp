@@ -22,6 +22,9 @@
 #include <php_driver_globals.h>
 #include <php_driver_types.h>
 #include <php_ini.h>
+#include <util/bind.h>
+#include <util/future.h>
+#include <util/prepared_cache.h>
 #include <util/ref.h>
 #include <uv.h>
 #include <version.h>
@@ -58,7 +61,6 @@ BEGIN_EXTERN_C()
 /* Resources */
 #define PHP_DRIVER_CLUSTER_RES_NAME PHP_DRIVER_NAMESPACE " Cluster"
 #define PHP_DRIVER_SESSION_RES_NAME PHP_DRIVER_NAMESPACE " Session"
-#define PHP_DRIVER_PREPARED_STATEMENT_RES_NAME PHP_DRIVER_NAMESPACE " PreparedStatement"
 
 static uv_once_t log_once = UV_ONCE_INIT;
 static char *log_location = nullptr;
@@ -120,6 +122,7 @@ END_EXTERN_C()
 PHP_INI_BEGIN()
   PHP_INI_ENTRY(PHP_DRIVER_NAME ".log", PHP_DRIVER_DEFAULT_LOG, PHP_INI_ALL, OnUpdateLog)
   PHP_INI_ENTRY(PHP_DRIVER_NAME ".log_level", PHP_DRIVER_DEFAULT_LOG_LEVEL, PHP_INI_ALL, OnUpdateLogLevel)
+  PHP_INI_ENTRY(PHP_DRIVER_NAME ".prepared_cache_size", PHP_DRIVER_DEFAULT_PREPARED_CACHE_SIZE, PHP_INI_SYSTEM, OnUpdatePreparedCacheSize)
 PHP_INI_END()
 // clang-format on
 
@@ -154,24 +157,6 @@ static void php_driver_session_dtor(zend_resource* rsrc) {
   }
 }
 
-static int le_php_driver_prepared_statement_res;
-int php_le_php_driver_prepared_statement() { return le_php_driver_prepared_statement_res; }
-static void php_driver_prepared_statement_dtor(zend_resource* rsrc) {
-  auto *preparedStmt = (php_driver_pprepared_statement *)rsrc->ptr;
-
-  if (preparedStmt) {
-    cass_future_free(preparedStmt->future);
-    php_driver_del_peref(&preparedStmt->ref, 1);
-    pefree(preparedStmt, 1);
-
-    // clang-format off
-    PHP_DRIVER_G(persistent_prepared_statements)--;
-    // clang-format on
-
-    rsrc->ptr = nullptr;
-  }
-}
-
 static void php_driver_log(const CassLogMessage *message, void *data);
 
 static void php_driver_log_cleanup() {
@@ -364,6 +349,29 @@ PHP_INI_MH(OnUpdateLogLevel) {
   return SUCCESS;
 }
 
+PHP_INI_MH(OnUpdatePreparedCacheSize) {
+  zend_long size;
+
+  if (!new_value) {
+    return SUCCESS;
+  }
+
+  size = ZEND_STRTOL(ZSTR_VAL(new_value), nullptr, 10);
+  if (size < 0) {
+    php_error_docref(nullptr, E_NOTICE,
+                     PHP_DRIVER_NAME " | Invalid prepared cache size '%s', disabling the cache",
+                     ZSTR_VAL(new_value));
+    size = 0;
+  }
+
+  PHP_DRIVER_G(prepared_cache_size) = size;
+  if (PHP_DRIVER_G(prepared_cache)) {
+    php_driver_prepared_cache_trim(PHP_DRIVER_G(prepared_cache), size);
+  }
+
+  return SUCCESS;
+}
+
 PHP_INI_MH(OnUpdateLog) {
   /* If TSRM is enabled then the last thread to update this wins */
 
@@ -396,7 +404,10 @@ static PHP_GINIT_FUNCTION(php_driver) {
   php_driver_globals->uuid_gen_pid = 0;
   php_driver_globals->persistent_clusters = 0;
   php_driver_globals->persistent_sessions = 0;
-  php_driver_globals->persistent_prepared_statements = 0;
+  php_driver_globals->prepared_cache = php_driver_prepared_cache_new();
+  php_driver_globals->prepared_cache_size = 0;
+  php_driver_globals->pending_releases = nullptr;
+  php_driver_globals->type_cache = nullptr;
   ZVAL_UNDEF(&php_driver_globals->type_varchar);
   ZVAL_UNDEF(&php_driver_globals->type_text);
   ZVAL_UNDEF(&php_driver_globals->type_blob);
@@ -420,6 +431,7 @@ static PHP_GSHUTDOWN_FUNCTION(php_driver) {
   if (php_driver_globals->uuid_gen) {
     cass_uuid_gen_free(php_driver_globals->uuid_gen);
   }
+  php_driver_prepared_cache_free(php_driver_globals->prepared_cache);
   php_driver_log_cleanup();
 }
 
@@ -432,10 +444,6 @@ PHP_MINIT_FUNCTION(php_driver) {
   le_php_driver_session_res = zend_register_list_destructors_ex(
       nullptr, php_driver_session_dtor, PHP_DRIVER_SESSION_RES_NAME, module_number);
 
-  le_php_driver_prepared_statement_res =
-      zend_register_list_destructors_ex(nullptr, php_driver_prepared_statement_dtor,
-                                        PHP_DRIVER_PREPARED_STATEMENT_RES_NAME, module_number);
-
   php_driver_define_Exception();
   php_driver_define_InvalidArgumentException();
   php_driver_define_DomainException();
@@ -497,6 +505,7 @@ PHP_MINIT_FUNCTION(php_driver) {
   php_driver_define_FutureSession();
   php_driver_define_FutureValue();
   php_driver_define_FutureClose();
+  php_driver_define_Futures();
   php_driver_define_Session();
   php_driver_define_DefaultSession();
   php_driver_define_SSLOptions();
@@ -505,6 +514,7 @@ PHP_MINIT_FUNCTION(php_driver) {
   php_driver_define_SimpleStatement();
   php_driver_define_PreparedStatement();
   php_driver_define_BatchStatement();
+  php_driver_define_BoundStatement();
   php_driver_define_ExecutionOptions();
   php_driver_define_Rows();
 
@@ -544,24 +554,39 @@ PHP_MINIT_FUNCTION(php_driver) {
   php_driver_define_TimestampGeneratorMonotonic();
   php_driver_define_TimestampGeneratorServerSide();
 
+  php_driver_bind_startup();
+
   return SUCCESS;
 }
 
-PHP_MSHUTDOWN_FUNCTION(php_driver) { return SUCCESS; }
+PHP_MSHUTDOWN_FUNCTION(php_driver) {
+  php_driver_bind_shutdown();
+
+  return SUCCESS;
+}
 
 PHP_RINIT_FUNCTION(php_driver) {
 #define XX_SCALAR(name, value) ZVAL_UNDEF(&PHP_DRIVER_G(type_##name));
   PHP_DRIVER_SCALAR_TYPES_MAP(XX_SCALAR)
 #undef XX_SCALAR
+  PHP_DRIVER_G(type_cache) = nullptr;
 
   return SUCCESS;
 }
 
 PHP_RSHUTDOWN_FUNCTION(php_driver) {
+  php_driver_future_release_completed(1);
+
 #define XX_SCALAR(name, value) PHP5TO7_ZVAL_MAYBE_DESTROY(PHP_DRIVER_G(type_##name));
   PHP_DRIVER_SCALAR_TYPES_MAP(XX_SCALAR)
 #undef XX_SCALAR
 
+  if (PHP_DRIVER_G(type_cache)) {
+    zend_hash_destroy(PHP_DRIVER_G(type_cache));
+    FREE_HASHTABLE(PHP_DRIVER_G(type_cache));
+    PHP_DRIVER_G(type_cache) = nullptr;
+  }
+
   return SUCCESS;
 }
 
@@ -584,9 +609,15 @@ PHP_MINFO_FUNCTION(php_driver) {
   snprintf(buf, sizeof(buf), "%d", PHP_DRIVER_G(persistent_sessions));
   php_info_print_table_row(2, "Persistent Sessions", buf);
 
-  snprintf(buf, sizeof(buf), "%d", PHP_DRIVER_G(persistent_prepared_statements));
+  snprintf(buf, sizeof(buf), "%u", zend_hash_num_elements(&PHP_DRIVER_G(prepared_cache)->entries));
   php_info_print_table_row(2, "Persistent Prepared Statements", buf);
 
+  snprintf(buf, sizeof(buf),
+           ZEND_ULONG_FMT " hits, " ZEND_ULONG_FMT " misses, " ZEND_ULONG_FMT " evictions",
+           PHP_DRIVER_G(prepared_cache)->hits, PHP_DRIVER_G(prepared_cache)->misses,
+           PHP_DRIVER_G(prepared_cache)->evictions);
+  php_info_print_table_row(2, "Prepared Statement Cache", buf);
+
   php_info_print_table_end();
 
   DISPLAY_INI_ENTRIES();
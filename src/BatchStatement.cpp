@@ -16,9 +16,18 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "src/BatchStatement.h"
+#include "util/bind.h"
+#include "util/future.h"
+#include "util/ref.h"
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_batch_statement_ce = NULL;
 
+static void free_batch(void *batch)
+{
+    cass_batch_free((CassBatch *)batch);
+}
+
 void php_driver_batch_statement_entry_dtor(zval* dest)
 {
     auto *batch_statement_entry = static_cast<php_driver_batch_statement_entry *>(Z_PTR_P(dest));
@@ -29,6 +38,107 @@ void php_driver_batch_statement_entry_dtor(zval* dest)
     efree(batch_statement_entry);
 }
 
+/* Binds the statement of an entry and adds it to the driver batch */
+static int php_driver_batch_statement_bind_entry(CassBatch *batch, php_driver_batch_statement_entry *entry)
+{
+    php_driver_statement *statement;
+    php_driver_statement simple_statement;
+    CassStatement *stmt;
+
+    if (Z_TYPE(entry->statement) == IS_STRING)
+    {
+        simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
+        simple_statement.data.simple.cql = Z_STRVAL(entry->statement);
+        statement = &simple_statement;
+    }
+    else
+    {
+        statement = PHP_DRIVER_GET_STATEMENT(&entry->statement);
+    }
+
+    stmt = php_driver_create_statement(statement, !Z_ISUNDEF(entry->arguments) ? Z_ARRVAL(entry->arguments) : NULL);
+
+    if (!stmt)
+    {
+        return FAILURE;
+    }
+
+    cass_batch_add_statement(batch, stmt);
+    cass_statement_free(stmt);
+
+    return SUCCESS;
+}
+
+static int php_driver_batch_statement_rebuild(php_driver_statement *self)
+{
+    CassBatch *batch = cass_batch_new(self->data.batch.type);
+    zval *current;
+
+    ZEND_HASH_FOREACH_VAL(&self->data.batch.statements, current)
+    {
+        if (php_driver_batch_statement_bind_entry(batch, (php_driver_batch_statement_entry *)Z_PTR_P(current)) ==
+            FAILURE)
+        {
+            cass_batch_free(batch);
+            return FAILURE;
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    php_driver_del_ref(&self->data.batch.batch);
+    self->data.batch.batch = php_driver_new_ref(batch, free_batch);
+
+    return SUCCESS;
+}
+
+php_driver_ref *php_driver_batch_statement_acquire(php_driver_statement *self, CassConsistency consistency,
+                                                   CassRetryPolicy *retry_policy, cass_int64_t timestamp,
+                                                   zend_string *execution_profile)
+{
+    CassBatch *batch;
+    CassError rc;
+
+    if (self->data.batch.batch != NULL && self->data.batch.batch->count > 1)
+    {
+        php_driver_future_release_completed(0);
+    }
+
+    /* A batch still referenced by a pending request can't be modified */
+    if ((self->data.batch.batch == NULL || self->data.batch.batch->count > 1) &&
+        php_driver_batch_statement_rebuild(self) == FAILURE)
+    {
+        return NULL;
+    }
+
+    batch = (CassBatch *)self->data.batch.batch->data;
+
+    rc = cass_batch_set_consistency(batch, consistency);
+
+    if (rc == CASS_OK)
+    {
+        rc = cass_batch_set_retry_policy(batch, retry_policy);
+    }
+
+    if (rc == CASS_OK)
+    {
+        rc = cass_batch_set_timestamp(batch, timestamp);
+    }
+
+    if (rc == CASS_OK)
+    {
+        rc = cass_batch_set_execution_profile_n(batch, execution_profile ? ZSTR_VAL(execution_profile) : "",
+                                                execution_profile ? ZSTR_LEN(execution_profile) : 0);
+    }
+
+    if (rc != CASS_OK)
+    {
+        zend_throw_exception_ex(exception_class(rc), rc, "%s", cass_error_desc(rc));
+        return NULL;
+    }
+
+    return php_driver_add_ref(self->data.batch.batch);
+}
+
 PHP_METHOD(BatchStatement, __construct)
 {
     zval *type = NULL;
@@ -67,10 +177,7 @@ PHP_METHOD(BatchStatement, add)
     zval *arguments = NULL;
     php_driver_batch_statement_entry *batch_statement_entry = NULL;
     php_driver_statement *self = NULL;
-
-#if PHP_MAJOR_VERSION >= 7
     zval entry;
-#endif
 
     if (zend_parse_parameters(ZEND_NUM_ARGS() , "z|z", &statement, &arguments) == FAILURE)
     {
@@ -97,13 +204,48 @@ PHP_METHOD(BatchStatement, add)
         ZVAL_COPY(&batch_statement_entry->arguments, arguments);
     }
 
-#if PHP_MAJOR_VERSION >= 7
     ZVAL_PTR(&entry, batch_statement_entry);
+
+    /* Entries are bound right away so executing the batch doesn't rebind them */
+    if (self->data.batch.batch != NULL && self->data.batch.batch->count > 1)
+    {
+        php_driver_future_release_completed(0);
+    }
+
+    if (self->data.batch.batch == NULL)
+    {
+        self->data.batch.batch = php_driver_new_ref(cass_batch_new(self->data.batch.type), free_batch);
+    }
+    else if (self->data.batch.batch->count > 1 && php_driver_batch_statement_rebuild(self) == FAILURE)
+    {
+        php_driver_batch_statement_entry_dtor(&entry);
+        return;
+    }
+
+    if (php_driver_batch_statement_bind_entry((CassBatch *)self->data.batch.batch->data, batch_statement_entry) ==
+        FAILURE)
+    {
+        php_driver_batch_statement_entry_dtor(&entry);
+        return;
+    }
+
     zend_hash_next_index_insert(&self->data.batch.statements, &entry);
-#else
-    zend_hash_next_index_insert(&self->data.batch.statements, &batch_statement_entry,
-                                sizeof(php_driver_batch_statement_entry *), NULL);
-#endif
+
+    RETURN_ZVAL(getThis(), 1, 0);
+}
+
+PHP_METHOD(BatchStatement, count)
+{
+    php_driver_statement *self = NULL;
+
+    if (zend_parse_parameters_none() == FAILURE)
+    {
+        return;
+    }
+
+    self = PHP_DRIVER_GET_STATEMENT(getThis());
+
+    RETURN_LONG(zend_hash_num_elements(&self->data.batch.statements));
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 0)
@@ -115,9 +257,13 @@ ZEND_ARG_INFO(0, statement)
 ZEND_ARG_ARRAY_INFO(0, arguments, 1)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_TENTATIVE_RETURN_TYPE_INFO_EX(arginfo_count, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_batch_statement_methods[] = {
     PHP_ME(BatchStatement, __construct, arginfo__construct, ZEND_ACC_PUBLIC | ZEND_ACC_CTOR)
-        PHP_ME(BatchStatement, add, arginfo_add, ZEND_ACC_PUBLIC) PHP_FE_END};
+        PHP_ME(BatchStatement, add, arginfo_add, ZEND_ACC_PUBLIC)
+            PHP_ME(BatchStatement, count, arginfo_count, ZEND_ACC_PUBLIC) PHP_FE_END};
 
 static zend_object_handlers php_driver_batch_statement_handlers;
 
@@ -150,6 +296,7 @@ static void php_driver_batch_statement_free(zend_object *object )
     php_driver_statement *self = PHP5TO7_ZEND_OBJECT_GET(statement, object);
 
     zend_hash_destroy(&self->data.batch.statements);
+    php_driver_del_ref(&self->data.batch.batch);
 
     zend_object_std_dtor(&self->zendObject);
 
@@ -161,6 +308,7 @@ static zend_object* php_driver_batch_statement_new(zend_class_entry *ce )
 
     self->type = PHP_DRIVER_BATCH_STATEMENT;
     self->data.batch.type = CASS_BATCH_TYPE_LOGGED;
+    self->data.batch.batch = NULL;
     zend_hash_init(&self->data.batch.statements, 0, NULL, (dtor_func_t)php_driver_batch_statement_entry_dtor, 0);
 
     PHP5TO7_ZEND_OBJECT_INIT_EX(statement, batch_statement, self, ce);
@@ -172,7 +320,7 @@ void php_driver_define_BatchStatement()
 
     INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\BatchStatement", php_driver_batch_statement_methods);
     php_driver_batch_statement_ce = zend_register_internal_class(&ce );
-    zend_class_implements(php_driver_batch_statement_ce , 1, php_driver_statement_ce);
+    zend_class_implements(php_driver_batch_statement_ce , 2, php_driver_statement_ce, zend_ce_countable);
     php_driver_batch_statement_ce->ce_flags |= ZEND_ACC_FINAL;
     php_driver_batch_statement_ce->create_object = php_driver_batch_statement_new;
 
@@ -17,6 +17,7 @@
 #include "php_driver.h"
 #include "php_driver_types.h"
 #include "util/bytes.h"
+#include "util/ref.h"
 #include "util/types.h"
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_blob_ce = NULL;
@@ -39,6 +40,13 @@ void php_driver_blob_init(INTERNAL_FUNCTION_PARAMETERS) {
     self = PHP_DRIVER_GET_BLOB(return_value);
   }
 
+  if (self->ref) {
+    php_driver_del_ref(&self->ref);
+    self->ref = NULL;
+  } else if (self->data) {
+    efree(self->data);
+  }
+
   self->data =
       static_cast<cass_byte_t *>(emalloc(string_len * sizeof(cass_byte_t)));
   self->size = string_len;
@@ -190,7 +198,9 @@ static unsigned php_driver_blob_hash_value(zval *obj) {
 static void php_driver_blob_free(zend_object *object) {
   php_driver_blob *self = PHP5TO7_ZEND_OBJECT_GET(blob, object);
 
-  if (self->data) {
+  if (self->ref) {
+    php_driver_del_ref(&self->ref);
+  } else if (self->data) {
     efree(self->data);
   }
 
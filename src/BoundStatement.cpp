@@ -0,0 +1,350 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RetryPolicy/RetryPolicy.h>
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "src/BoundStatement.h"
+#include "src/ExecutionOptions.h"
+#include "util/bind.h"
+#include "util/future.h"
+#include "util/ref.h"
+BEGIN_EXTERN_C()
+zend_class_entry *php_driver_bound_statement_ce = NULL;
+
+static void
+free_statement(void *statement)
+{
+  cass_statement_free((CassStatement *) statement);
+}
+
+/* Creates a driver statement from the remembered arguments and options */
+static CassStatement *
+php_driver_bound_statement_build(php_driver_statement *self)
+{
+  php_driver_statement *prepared = PHP_DRIVER_GET_STATEMENT(&self->data.bound.prepared);
+  CassStatement *statement = cass_prepared_bind(prepared->data.prepared.prepared);
+  CassError rc = CASS_OK;
+
+  if (!Z_ISUNDEF(self->data.bound.arguments) &&
+      php_driver_bind_arguments(statement, prepared, Z_ARRVAL(self->data.bound.arguments)) == FAILURE) {
+    cass_statement_free(statement);
+    return NULL;
+  }
+
+  if (self->data.bound.consistency >= 0)
+    rc = cass_statement_set_consistency(statement, (CassConsistency) self->data.bound.consistency);
+
+  if (rc == CASS_OK && self->data.bound.serial_consistency >= 0)
+    rc = cass_statement_set_serial_consistency(statement,
+                                               (CassConsistency) self->data.bound.serial_consistency);
+
+  if (rc == CASS_OK && self->data.bound.page_size >= 0)
+    rc = cass_statement_set_paging_size(statement, self->data.bound.page_size);
+
+  if (rc == CASS_OK && !Z_ISUNDEF(self->data.bound.retry_policy))
+    rc = cass_statement_set_retry_policy(statement,
+                                         Z_SCYLLADB_RETRY_POLICY_P(&self->data.bound.retry_policy)->policy);
+
+  if (rc == CASS_OK)
+    rc = cass_statement_set_timestamp(statement, self->data.bound.timestamp);
+
+  if (rc == CASS_OK && self->data.bound.execution_profile)
+    rc = cass_statement_set_execution_profile_n(statement,
+                                                ZSTR_VAL(self->data.bound.execution_profile),
+                                                ZSTR_LEN(self->data.bound.execution_profile));
+
+  if (rc != CASS_OK) {
+    cass_statement_free(statement);
+    zend_throw_exception_ex(exception_class(rc), rc, "%s", cass_error_desc(rc));
+    return NULL;
+  }
+
+  return statement;
+}
+
+static int
+php_driver_bound_statement_rebuild(php_driver_statement *self)
+{
+  CassStatement *statement = php_driver_bound_statement_build(self);
+
+  if (!statement)
+    return FAILURE;
+
+  php_driver_del_ref(&self->data.bound.statement);
+  self->data.bound.statement = php_driver_new_ref(statement, free_statement);
+
+  return SUCCESS;
+}
+
+int
+php_driver_bound_statement_init(php_driver_statement *self, zval *prepared, zval *arguments,
+                                zval *options)
+{
+  php_driver_execution_options local_opts;
+  php_driver_execution_options *opts = NULL;
+
+  ZVAL_COPY(&self->data.bound.prepared, prepared);
+
+  if (options && Z_TYPE_P(options) != IS_NULL) {
+    if (Z_TYPE_P(options) == IS_OBJECT &&
+        instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce)) {
+      opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
+    } else if (Z_TYPE_P(options) == IS_ARRAY) {
+      if (php_driver_execution_options_build_local_from_array(&local_opts, options) == FAILURE)
+        return FAILURE;
+      opts = &local_opts;
+    } else {
+      INVALID_ARGUMENT_VALUE(options, "an instance of " PHP_DRIVER_NAMESPACE
+                                      "\\ExecutionOptions or an array or null", FAILURE);
+    }
+
+    self->data.bound.consistency        = opts->consistency;
+    self->data.bound.serial_consistency = opts->serial_consistency;
+    self->data.bound.page_size          = opts->page_size;
+    self->data.bound.timestamp          = opts->timestamp;
+
+    if (!Z_ISUNDEF(opts->retry_policy))
+      ZVAL_COPY(&self->data.bound.retry_policy, &opts->retry_policy);
+
+    if (opts->execution_profile)
+      self->data.bound.execution_profile = zend_string_copy(opts->execution_profile);
+
+    if (!arguments && !Z_ISUNDEF(opts->arguments))
+      arguments = &opts->arguments;
+  }
+
+  if (arguments)
+    ZVAL_COPY(&self->data.bound.arguments, arguments);
+
+  return php_driver_bound_statement_rebuild(self);
+}
+
+php_driver_ref *
+php_driver_bound_statement_acquire(php_driver_statement *self, CassConsistency consistency,
+                                   long serial_consistency, int page_size,
+                                   const char *paging_state_token, size_t paging_state_token_size,
+                                   CassRetryPolicy *retry_policy, cass_int64_t timestamp,
+                                   zend_string *execution_profile)
+{
+  CassStatement *statement;
+  CassError rc = CASS_OK;
+
+  if (self->data.bound.statement->count > 1)
+    php_driver_future_release_completed(0);
+
+  /* A statement still referenced by a pending request or by paged rows can't
+   * be modified, those keep the values they were executed with.
+   */
+  if (self->data.bound.statement->count > 1 &&
+      php_driver_bound_statement_rebuild(self) == FAILURE)
+    return NULL;
+
+  statement = (CassStatement *) self->data.bound.statement->data;
+
+  /* Options given when binding take precedence over the execution ones */
+  if (self->data.bound.consistency < 0 && !self->data.bound.execution_profile)
+    rc = cass_statement_set_consistency(statement, consistency);
+
+  if (rc == CASS_OK && !self->data.bound.execution_profile)
+    rc = cass_statement_set_execution_profile_n(statement,
+                                                execution_profile ? ZSTR_VAL(execution_profile) : "",
+                                                execution_profile ? ZSTR_LEN(execution_profile) : 0);
+
+  /* Values of a previous execution are reset when they aren't given again */
+  if (rc == CASS_OK && self->data.bound.serial_consistency < 0)
+    rc = cass_statement_set_serial_consistency(statement,
+                                               serial_consistency >= 0
+                                                   ? (CassConsistency) serial_consistency
+                                                   : CASS_CONSISTENCY_UNKNOWN);
+
+  if (rc == CASS_OK && self->data.bound.page_size < 0 && page_size >= 0)
+    rc = cass_statement_set_paging_size(statement, page_size);
+
+  if (rc == CASS_OK && Z_ISUNDEF(self->data.bound.retry_policy))
+    rc = cass_statement_set_retry_policy(statement, retry_policy);
+
+  if (rc == CASS_OK && self->data.bound.timestamp == INT64_MIN)
+    rc = cass_statement_set_timestamp(statement, timestamp);
+
+  if (rc == CASS_OK)
+    rc = cass_statement_set_paging_state_token(statement,
+                                               paging_state_token ? paging_state_token : "",
+                                               paging_state_token ? paging_state_token_size : 0);
+
+  if (rc != CASS_OK) {
+    zend_throw_exception_ex(exception_class(rc), rc, "%s", cass_error_desc(rc));
+    return NULL;
+  }
+
+  return php_driver_add_ref(self->data.bound.statement);
+}
+
+PHP_METHOD(BoundStatement, __construct)
+{
+}
+
+PHP_METHOD(BoundStatement, bind)
+{
+  zval *arguments = NULL;
+  zval previous;
+  php_driver_statement *self = NULL;
+  php_driver_statement *prepared = NULL;
+  zend_bool in_place;
+  int rc;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a", &arguments) == FAILURE) {
+    return;
+  }
+
+  self     = PHP_DRIVER_GET_STATEMENT(getThis());
+  prepared = PHP_DRIVER_GET_STATEMENT(&self->data.bound.prepared);
+
+  if (self->data.bound.statement->count > 1)
+    php_driver_future_release_completed(0);
+  in_place = self->data.bound.statement->count == 1;
+
+  /* Parameters that are not given keep their previous value, whichever way
+   * the driver statement gets updated.
+   */
+  previous = self->data.bound.arguments;
+  if (Z_ISUNDEF(previous)) {
+    ZVAL_COPY(&self->data.bound.arguments, arguments);
+  } else {
+    ZVAL_ARR(&self->data.bound.arguments, zend_array_dup(Z_ARRVAL(previous)));
+    zend_hash_merge(Z_ARRVAL(self->data.bound.arguments), Z_ARRVAL_P(arguments), zval_add_ref, 1);
+  }
+
+  if (in_place)
+    rc = php_driver_bind_arguments((CassStatement *) self->data.bound.statement->data, prepared,
+                                   Z_ARRVAL_P(arguments));
+  else
+    rc = php_driver_bound_statement_rebuild(self);
+
+  if (rc == FAILURE) {
+    zval_ptr_dtor(&self->data.bound.arguments);
+    self->data.bound.arguments = previous;
+
+    /* Values bound before the failing one are reverted to the previous arguments */
+    if (in_place)
+      php_driver_bound_statement_rebuild(self);
+    return;
+  }
+
+  PHP5TO7_ZVAL_MAYBE_DESTROY(previous);
+
+  RETURN_ZVAL(getThis(), 1, 0);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_bind, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, arguments)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry php_driver_bound_statement_methods[] = {
+  PHP_ME(BoundStatement, __construct, arginfo_none, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+  PHP_ME(BoundStatement, bind, arginfo_bind, ZEND_ACC_PUBLIC)
+  PHP_FE_END
+};
+
+static zend_object_handlers php_driver_bound_statement_handlers;
+
+static HashTable *
+php_driver_bound_statement_properties(
+#if PHP_MAJOR_VERSION >= 8
+        zend_object *object
+#else
+        zendObject *object
+#endif
+)
+{
+  HashTable *props = zend_std_get_properties(object );
+
+  return props;
+}
+
+static int
+php_driver_bound_statement_compare(zval *obj1, zval *obj2 )
+{
+#if PHP_MAJOR_VERSION >= 8
+  ZEND_COMPARE_OBJECTS_FALLBACK(obj1, obj2);
+#endif
+  if (Z_OBJCE_P(obj1) != Z_OBJCE_P(obj2))
+    return 1; /* different classes */
+
+  return Z_OBJ_HANDLE_P(obj1) != Z_OBJ_HANDLE_P(obj2);
+}
+
+static void
+php_driver_bound_statement_free(zend_object *object )
+{
+  php_driver_statement *self = PHP5TO7_ZEND_OBJECT_GET(statement, object);
+
+  php_driver_del_ref(&self->data.bound.statement);
+  PHP5TO7_ZVAL_MAYBE_DESTROY(self->data.bound.prepared);
+  PHP5TO7_ZVAL_MAYBE_DESTROY(self->data.bound.arguments);
+  PHP5TO7_ZVAL_MAYBE_DESTROY(self->data.bound.retry_policy);
+
+  if (self->data.bound.execution_profile)
+    zend_string_release(self->data.bound.execution_profile);
+
+  zend_object_std_dtor(&self->zendObject);
+
+}
+
+static zend_object*
+php_driver_bound_statement_new(zend_class_entry *ce )
+{
+  php_driver_statement *self =
+      PHP5TO7_ZEND_OBJECT_ECALLOC(statement, ce);
+
+  self->type = PHP_DRIVER_BOUND_STATEMENT;
+  self->data.bound.statement          = NULL;
+  self->data.bound.consistency        = -1;
+  self->data.bound.serial_consistency = -1;
+  self->data.bound.page_size          = -1;
+  self->data.bound.timestamp          = INT64_MIN;
+  self->data.bound.execution_profile  = NULL;
+  ZVAL_UNDEF(&self->data.bound.prepared);
+  ZVAL_UNDEF(&self->data.bound.arguments);
+  ZVAL_UNDEF(&self->data.bound.retry_policy);
+
+  PHP5TO7_ZEND_OBJECT_INIT_EX(statement, bound_statement, self, ce);
+}
+
+void php_driver_define_BoundStatement()
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\BoundStatement", php_driver_bound_statement_methods);
+  php_driver_bound_statement_ce = zend_register_internal_class(&ce );
+  zend_class_implements(php_driver_bound_statement_ce , 1, php_driver_statement_ce);
+  php_driver_bound_statement_ce->ce_flags     |= ZEND_ACC_FINAL;
+  php_driver_bound_statement_ce->create_object = php_driver_bound_statement_new;
+
+  memcpy(&php_driver_bound_statement_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+  php_driver_bound_statement_handlers.get_properties  = php_driver_bound_statement_properties;
+#if PHP_MAJOR_VERSION >= 8
+  php_driver_bound_statement_handlers.compare = php_driver_bound_statement_compare;
+#else
+  php_driver_bound_statement_handlers.compare_objects = php_driver_bound_statement_compare;
+#endif
+  php_driver_bound_statement_handlers.clone_obj = NULL;
+}
+END_EXTERN_C()
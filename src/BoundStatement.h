@@ -0,0 +1,28 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+BEGIN_EXTERN_C()
+int php_driver_bound_statement_init(php_driver_statement *self, zval *prepared, zval *arguments,
+                                    zval *options);
+php_driver_ref *php_driver_bound_statement_acquire(php_driver_statement *self, CassConsistency consistency,
+                                                   long serial_consistency, int page_size,
+                                                   const char *paging_state_token,
+                                                   size_t paging_state_token_size,
+                                                   CassRetryPolicy *retry_policy, cass_int64_t timestamp,
+                                                   zend_string *execution_profile);
+END_EXTERN_C()
@@ -23,9 +23,11 @@
 #include <php_driver_types.h>
 #include <ZendCPP/ZendCPP.hpp>
 #include <util/consistency.h>
+#include <util/future.h>
 
 #include "BuilderHandlers.h"
 #include "Cluster.h"
+#include "src/ExecutionOptions.h"
 #include "zend_portability.h"
 
 BEGIN_EXTERN_C()
@@ -107,6 +109,91 @@ static zend_always_inline void php_driver_set_timeout(INTERNAL_FUNCTION_PARAMETE
     RETURN_ZVAL(getThis(), 1, 0);
 }
 
+/* Identifies the execution profiles of a persistent cluster, retry policies aren't part of the key */
+static zend_string *php_driver_execution_profiles_key(HashTable *profiles)
+{
+    smart_str key{nullptr, 0};
+    zend_string *name;
+    zval *current;
+
+    if (profiles == nullptr)
+    {
+        return ZSTR_EMPTY_ALLOC();
+    }
+
+    ZEND_HASH_FOREACH_STR_KEY_VAL(profiles, name, current)
+    {
+        php_driver_execution_options *options = PHP_DRIVER_GET_EXECUTION_OPTIONS(current);
+        cass_duration_t timeout = 0;
+
+        if (!Z_ISUNDEF(options->timeout))
+        {
+            php_driver_future_parse_timeout(&options->timeout, &timeout);
+        }
+
+        smart_str_append(&key, name);
+        smart_str_append_printf(&key, "=%ld/%ld/%lu;", options->consistency, options->serial_consistency,
+                                static_cast<unsigned long>(timeout));
+    }
+    ZEND_HASH_FOREACH_END();
+
+    smart_str_0(&key);
+    return key.s != nullptr ? key.s : ZSTR_EMPTY_ALLOC();
+}
+
+static int php_driver_set_execution_profiles(CassCluster *cluster, HashTable *profiles)
+{
+    zend_string *name;
+    zval *current;
+
+    if (profiles == nullptr)
+    {
+        return SUCCESS;
+    }
+
+    ZEND_HASH_FOREACH_STR_KEY_VAL(profiles, name, current)
+    {
+        php_driver_execution_options *options = PHP_DRIVER_GET_EXECUTION_OPTIONS(current);
+        CassExecProfile *profile = cass_execution_profile_new();
+        CassError rc = CASS_OK;
+
+        if (options->consistency >= 0)
+        {
+            rc = cass_execution_profile_set_consistency(profile, static_cast<CassConsistency>(options->consistency));
+        }
+
+        if (rc == CASS_OK && options->serial_consistency >= 0)
+        {
+            rc = cass_execution_profile_set_serial_consistency(
+                profile, static_cast<CassConsistency>(options->serial_consistency));
+        }
+
+        if (rc == CASS_OK && !Z_ISUNDEF(options->timeout))
+        {
+            cass_duration_t timeout = 0;
+            php_driver_future_parse_timeout(&options->timeout, &timeout);
+            rc = cass_execution_profile_set_request_timeout(profile, timeout / 1000);
+        }
+
+        if (rc == CASS_OK && !Z_ISUNDEF(options->retry_policy))
+        {
+            rc = cass_execution_profile_set_retry_policy(
+                profile, ZendCPP::ObjectFetch<php_driver_retry_policy>(&options->retry_policy)->policy);
+        }
+
+        if (rc == CASS_OK)
+        {
+            rc = cass_cluster_set_execution_profile_n(cluster, ZSTR_VAL(name), ZSTR_LEN(name), profile);
+        }
+
+        cass_execution_profile_free(profile);
+        ASSERT_SUCCESS_VALUE(rc, FAILURE);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    return SUCCESS;
+}
+
 ZEND_METHOD(Cassandra_Cluster_Builder, build)
 {
     CassError rc;
@@ -121,11 +208,19 @@ ZEND_METHOD(Cassandra_Cluster_Builder, build)
 
     ZVAL_COPY(&cluster->default_timeout, &self->default_timeout);
 
+    if (self->warmup_statements != nullptr)
+    {
+        GC_ADDREF(self->warmup_statements);
+        cluster->warmup_statements = self->warmup_statements;
+    }
+
     if (self->persist)
     {
+        zend_string *profiles_key = php_driver_execution_profiles_key(self->execution_profiles);
+
         cluster->hash_key_len = spprintf(
             &cluster->hash_key, 0,
-            PHP_DRIVER_NAME ":%s:%d:%d:%s:%d:%d:%d:%s:%s:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%s:%s:%s:%s",
+            PHP_DRIVER_NAME ":%s:%d:%d:%s:%d:%d:%d:%s:%s:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%d:%s:%s:%s:%s:%s",
             ZSTR_VAL(self->contact_points), self->port, self->load_balancing_policy, SAFE_ZEND_STRING(self->local_dc),
             self->used_hosts_per_remote_dc, self->allow_remote_dcs_for_local_cl, self->use_token_aware_routing,
             SAFE_ZEND_STRING(self->username), SAFE_ZEND_STRING(self->password), self->connect_timeout,
@@ -135,7 +230,9 @@ ZEND_METHOD(Cassandra_Cluster_Builder, build)
             self->enable_hostname_resolution, self->enable_randomized_contact_points,
             self->connection_heartbeat_interval, SAFE_ZEND_STRING(self->whitelist_hosts),
             SAFE_ZEND_STRING(self->whitelist_dcs), SAFE_ZEND_STRING(self->blacklist_hosts),
-            SAFE_ZEND_STRING(self->blacklist_dcs));
+            SAFE_ZEND_STRING(self->blacklist_dcs), ZSTR_VAL(profiles_key));
+
+        zend_string_release(profiles_key);
 
         zval *le;
 
@@ -237,6 +334,11 @@ ZEND_METHOD(Cassandra_Cluster_Builder, build)
         cass_cluster_set_retry_policy(cluster->cluster, self->retry_policy->policy);
     }
 
+    if (php_driver_set_execution_profiles(cluster->cluster, self->execution_profiles) == FAILURE)
+    {
+        return;
+    }
+
     if (self->persist)
     {
         zval resource;
@@ -659,6 +761,94 @@ ZEND_METHOD(Cassandra_Cluster_Builder, withRetryPolicy)
 
     RETURN_ZVAL(getThis(), 1, 0);
 }
+ZEND_METHOD(Cassandra_Cluster_Builder, withExecutionProfile)
+{
+    zend_string *name = nullptr;
+    zval *options = nullptr;
+    zval profile;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+    Z_PARAM_STR(name)
+    Z_PARAM_ZVAL(options)
+    ZEND_PARSE_PARAMETERS_END();
+
+    php_driver_cluster_builder *self = PHP_DRIVER_GET_CLUSTER_BUILDER(getThis());
+
+    if (Z_TYPE_P(options) == IS_ARRAY)
+    {
+        object_init_ex(&profile, php_driver_execution_options_ce);
+
+        if (php_driver_execution_options_build_from_array(PHP_DRIVER_GET_EXECUTION_OPTIONS(&profile), options) ==
+            FAILURE)
+        {
+            zval_ptr_dtor(&profile);
+            return;
+        }
+    }
+    else if (Z_TYPE_P(options) == IS_OBJECT && instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))
+    {
+        ZVAL_COPY(&profile, options);
+    }
+    else
+    {
+        throw_invalid_argument(options, "options",
+                               "an array or an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions");
+        return;
+    }
+
+    php_driver_execution_options *opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(&profile);
+
+    /* Everything else is specific to a single request */
+    if (!Z_ISUNDEF(opts->arguments) || opts->page_size >= 0 || opts->paging_state_token != nullptr ||
+        opts->timestamp != INT64_MIN || opts->native_options != 0 || opts->execution_profile != nullptr)
+    {
+        zval_ptr_dtor(&profile);
+        zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                "Execution profiles only support the consistency, serial_consistency, timeout and "
+                                "retry_policy options");
+        return;
+    }
+
+    if (self->execution_profiles == nullptr)
+    {
+        self->execution_profiles = zend_new_array(0);
+    }
+
+    zend_hash_update(self->execution_profiles, name, &profile);
+
+    RETURN_ZVAL(getThis(), 1, 0);
+}
+
+ZEND_METHOD(Cassandra_Cluster_Builder, withWarmup)
+{
+    HashTable *statements = nullptr;
+    zval *cql;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+    Z_PARAM_ARRAY_HT(statements)
+    ZEND_PARSE_PARAMETERS_END();
+
+    php_driver_cluster_builder *self = PHP_DRIVER_GET_CLUSTER_BUILDER(getThis());
+
+    ZEND_HASH_FOREACH_VAL(statements, cql)
+    {
+        if (Z_TYPE_P(cql) != IS_STRING)
+        {
+            throw_invalid_argument(cql, "statements", "an array of strings");
+            return;
+        }
+    }
+    ZEND_HASH_FOREACH_END();
+
+    if (self->warmup_statements != nullptr)
+    {
+        zend_array_release(self->warmup_statements);
+    }
+
+    self->warmup_statements = zend_array_dup(statements);
+
+    RETURN_ZVAL(getThis(), 1, 0);
+}
 ZEND_METHOD(Cassandra_Cluster_Builder, withTimestampGenerator)
 {
     zval *timestamp_gen = nullptr;
@@ -111,6 +111,14 @@ namespace Cassandra\Cluster {
         {
         }
 
+        public function withExecutionProfile(string $name, array|\Cassandra\ExecutionOptions $options): Builder
+        {
+        }
+
+        public function withWarmup(array $statements): Builder
+        {
+        }
+
         public function withTimestampGenerator(\Cassandra\TimestampGenerator $generator): Builder
         {
         }
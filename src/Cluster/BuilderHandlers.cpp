@@ -49,6 +49,8 @@ static HashTable *php_driver_cluster_builder_properties(zend_object *object)
     zval hostnameResolution;
     zval randomizedContactPoints;
     zval connectionHeartbeatInterval;
+    zval executionProfiles;
+    zval warmupStatements;
 
     php_driver_cluster_builder *self = php_driver_cluster_builder_object_fetch(object);
     HashTable *props = zend_std_get_properties(object);
@@ -185,6 +187,24 @@ static HashTable *php_driver_cluster_builder_properties(zend_object *object)
 
     ZVAL_LONG(&connectionHeartbeatInterval, self->connection_heartbeat_interval);
 
+    if (self->execution_profiles != nullptr)
+    {
+        ZVAL_ARR(&executionProfiles, zend_array_dup(self->execution_profiles));
+    }
+    else
+    {
+        array_init(&executionProfiles);
+    }
+
+    if (self->warmup_statements != nullptr)
+    {
+        ZVAL_ARR(&warmupStatements, zend_array_dup(self->warmup_statements));
+    }
+    else
+    {
+        array_init(&warmupStatements);
+    }
+
     PHP5TO7_ZEND_HASH_UPDATE(props, "contactPoints", sizeof("contactPoints"), &contactPoints, sizeof(zval));
     PHP5TO7_ZEND_HASH_UPDATE(props, "loadBalancingPolicy", sizeof("loadBalancingPolicy"), &loadBalancingPolicy,
                              sizeof(zval));
@@ -231,6 +251,10 @@ static HashTable *php_driver_cluster_builder_properties(zend_object *object)
                              &randomizedContactPoints, sizeof(zval));
     PHP5TO7_ZEND_HASH_UPDATE(props, "connectionHeartbeatInterval", sizeof("connectionHeartbeatInterval"),
                              &connectionHeartbeatInterval, sizeof(zval));
+    PHP5TO7_ZEND_HASH_UPDATE(props, "executionProfiles", sizeof("executionProfiles"), &executionProfiles,
+                             sizeof(zval));
+    PHP5TO7_ZEND_HASH_UPDATE(props, "warmupStatements", sizeof("warmupStatements"), &warmupStatements,
+                             sizeof(zval));
 
     return props;
 }
@@ -313,6 +337,19 @@ static void php_driver_cluster_builder_free(zend_object *object)
         zend_object_release(&self->timestamp_gen->zendObject);
         self->timestamp_gen = nullptr;
     }
+
+    if (self->execution_profiles != nullptr)
+    {
+        zend_array_destroy(self->execution_profiles);
+        self->execution_profiles = nullptr;
+    self->warmup_statements = nullptr;
+    }
+
+    if (self->warmup_statements != nullptr)
+    {
+        zend_array_release(self->warmup_statements);
+        self->warmup_statements = nullptr;
+    }
 }
 zend_object* php_driver_cluster_builder_new(zend_class_entry *ce)
 {
@@ -353,6 +390,7 @@ zend_object* php_driver_cluster_builder_new(zend_class_entry *ce)
     self->timestamp_gen = nullptr;
     self->retry_policy = nullptr;
     self->ssl_options = nullptr;
+    self->execution_profiles = nullptr;
 
     ZVAL_UNDEF(&self->default_timeout);
 
@@ -90,6 +90,15 @@ ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_Cassandra_Cluster_Builder_w
 	ZEND_ARG_OBJ_INFO(0, policy, Cassandra\\RetryPolicy, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_Cassandra_Cluster_Builder_withExecutionProfile, 0, 2, Cassandra\\Cluster\\Builder, 0)
+	ZEND_ARG_TYPE_INFO(0, name, IS_STRING, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, options, Cassandra\\ExecutionOptions, MAY_BE_ARRAY, NULL)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_Cassandra_Cluster_Builder_withWarmup, 0, 1, Cassandra\\Cluster\\Builder, 0)
+	ZEND_ARG_TYPE_INFO(0, statements, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_Cassandra_Cluster_Builder_withTimestampGenerator, 0, 1, Cassandra\\Cluster\\Builder, 0)
 	ZEND_ARG_OBJ_INFO(0, generator, Cassandra\\TimestampGenerator, 0)
 ZEND_END_ARG_INFO()
@@ -131,6 +140,8 @@ ZEND_METHOD(Cassandra_Cluster_Builder, withLatencyAwareRouting);
 ZEND_METHOD(Cassandra_Cluster_Builder, withTCPNodelay);
 ZEND_METHOD(Cassandra_Cluster_Builder, withTCPKeepalive);
 ZEND_METHOD(Cassandra_Cluster_Builder, withRetryPolicy);
+ZEND_METHOD(Cassandra_Cluster_Builder, withExecutionProfile);
+ZEND_METHOD(Cassandra_Cluster_Builder, withWarmup);
 ZEND_METHOD(Cassandra_Cluster_Builder, withTimestampGenerator);
 ZEND_METHOD(Cassandra_Cluster_Builder, withSchemaMetadata);
 ZEND_METHOD(Cassandra_Cluster_Builder, withHostnameResolution);
@@ -165,6 +176,8 @@ static const zend_function_entry class_Cassandra_Cluster_Builder_methods[] = {
 	ZEND_ME(Cassandra_Cluster_Builder, withTCPNodelay, arginfo_class_Cassandra_Cluster_Builder_withTCPNodelay, ZEND_ACC_PUBLIC)
 	ZEND_ME(Cassandra_Cluster_Builder, withTCPKeepalive, arginfo_class_Cassandra_Cluster_Builder_withTCPKeepalive, ZEND_ACC_PUBLIC)
 	ZEND_ME(Cassandra_Cluster_Builder, withRetryPolicy, arginfo_class_Cassandra_Cluster_Builder_withRetryPolicy, ZEND_ACC_PUBLIC)
+	ZEND_ME(Cassandra_Cluster_Builder, withExecutionProfile, arginfo_class_Cassandra_Cluster_Builder_withExecutionProfile, ZEND_ACC_PUBLIC)
+	ZEND_ME(Cassandra_Cluster_Builder, withWarmup, arginfo_class_Cassandra_Cluster_Builder_withWarmup, ZEND_ACC_PUBLIC)
 	ZEND_ME(Cassandra_Cluster_Builder, withTimestampGenerator, arginfo_class_Cassandra_Cluster_Builder_withTimestampGenerator, ZEND_ACC_PUBLIC)
 	ZEND_ME(Cassandra_Cluster_Builder, withSchemaMetadata, arginfo_class_Cassandra_Cluster_Builder_withSchemaMetadata, ZEND_ACC_PUBLIC)
 	ZEND_ME(Cassandra_Cluster_Builder, withHostnameResolution, arginfo_class_Cassandra_Cluster_Builder_withHostnameResolution, ZEND_ACC_PUBLIC)
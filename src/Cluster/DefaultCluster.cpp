@@ -18,8 +18,10 @@
 #include <php_driver_globals.h>
 #include <php_driver_types.h>
 #include <util/future.h>
+#include <util/prepared_cache.h>
 #include <util/ref.h>
 
+#include <src/DefaultSession.h>
 #include "Cluster.h"
 #include "DefaultClusterHandlers.h"
 
@@ -45,12 +47,19 @@ ZEND_METHOD(Cassandra_DefaultCluster, connect)
     char *hash_key;
     size_t hash_key_len = 0;
     php_driver_psession *psession;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    cass_duration_t timeout_us;
 
     if (zend_parse_parameters(ZEND_NUM_ARGS(), "|sz", &keyspace, &keyspace_len, &timeout) == FAILURE)
     {
         return;
     }
 
+    if (php_driver_future_parse_timeout(timeout, &timeout_us) == FAILURE)
+    {
+        return;
+    }
+
     self = PHP_DRIVER_GET_CLUSTER(getThis());
 
     object_init_ex(return_value, php_driver_default_session_ce);
@@ -72,6 +81,7 @@ ZEND_METHOD(Cassandra_DefaultCluster, connect)
         zval *le;
 
         hash_key_len = spprintf(&hash_key, 0, "%s:session:%s", self->hash_key, SAFE_STR(keyspace));
+        session->prepared_scope = php_driver_prepared_cache_scope(hash_key, hash_key_len);
 
         if (PHP5TO7_ZEND_HASH_FIND(&EG(persistent_list), hash_key, hash_key_len + 1, le) &&
             Z_RES_P(le)->type == php_le_php_driver_session())
@@ -140,7 +150,11 @@ ZEND_METHOD(Cassandra_DefaultCluster, connect)
     }
 
     if (session->persist)
+    {
+        php_driver_session_warmup(session, psession, self->warmup_statements,
+                                  php_driver_future_time_left(timeout_us, start));
         efree(hash_key);
+    }
 }
 
 ZEND_METHOD(Cassandra_DefaultCluster, connectAsync)
@@ -164,6 +178,12 @@ ZEND_METHOD(Cassandra_DefaultCluster, connectAsync)
 
     future->persist = self->persist;
 
+    if (self->warmup_statements != nullptr)
+    {
+        GC_ADDREF(self->warmup_statements);
+        future->warmup_statements = self->warmup_statements;
+    }
+
     if (self->persist)
     {
         zval *le;
@@ -43,6 +43,12 @@ static void php_driver_default_cluster_free(zend_object *object)
         zval_ptr_dtor(&self->default_timeout);
         ZVAL_UNDEF(&self->default_timeout);
     }
+
+    if (self->warmup_statements != nullptr)
+    {
+        zend_array_release(self->warmup_statements);
+        self->warmup_statements = nullptr;
+    }
 }
 
 zend_object *php_driver_default_cluster_new(zend_class_entry *ce)
@@ -54,6 +60,7 @@ zend_object *php_driver_default_cluster_new(zend_class_entry *ce)
     self->default_page_size = 5000;
     self->persist = cass_false;
     self->hash_key = nullptr;
+    self->warmup_statements = nullptr;
 
     ZVAL_UNDEF(&self->default_timeout);
 
@@ -30,14 +30,14 @@ php_driver_collection_add(php_driver_collection *collection, zval *object)
 {
   PHP5TO7_ZEND_HASH_NEXT_INDEX_INSERT(&collection->values, object, sizeof(zval *));
   Z_TRY_ADDREF_P(object);
-  collection->dirty = 1;
+  PHP_DRIVER_VALUE_MUTATED(collection);
 }
 
 static int
 php_driver_collection_del(php_driver_collection *collection, ulong index)
 {
   if (zend_hash_index_del(&collection->values, index) == SUCCESS) {
-    collection->dirty = 1;
+    PHP_DRIVER_VALUE_MUTATED(collection);
     return 1;
   }
 
@@ -84,32 +84,75 @@ php_driver_collection_populate(php_driver_collection *collection, zval *array)
   } PHP5TO7_ZEND_HASH_FOREACH_END(&collection->values);
 }
 
-/* {{{ Collection::__construct(type) */
-PHP_METHOD(Collection, __construct)
+static int
+php_driver_collection_init_type(php_driver_collection *collection, zval *type)
 {
-  php_driver_collection *self;
-  zval *type;
-
-  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &type) == FAILURE)
-    return;
-
-  self = PHP_DRIVER_GET_COLLECTION(getThis());
-
   if (Z_TYPE_P(type) == IS_STRING) {
     CassValueType value_type;
     if (!php_driver_value_type(Z_STRVAL_P(type), &value_type))
-      return;
-    self->type = php_driver_type_collection_from_value_type(value_type);
+      return 0;
+    collection->type = php_driver_type_collection_from_value_type(value_type);
   } else if (Z_TYPE_P(type) == IS_OBJECT &&
              instanceof_function(Z_OBJCE_P(type), php_driver_type_ce)) {
     if (!php_driver_type_validate(type, "type")) {
-      return;
+      return 0;
     }
-    self->type = php_driver_type_collection(type);
+    collection->type = php_driver_type_collection(type);
     Z_ADDREF_P(type);
   } else {
-    INVALID_ARGUMENT(type, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Type");
+    throw_invalid_argument(type, "type", "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Type");
+    return 0;
   }
+
+  return 1;
+}
+
+/* {{{ Collection::__construct(type) */
+PHP_METHOD(Collection, __construct)
+{
+  zval *type;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &type) == FAILURE)
+    return;
+
+  php_driver_collection_init_type(PHP_DRIVER_GET_COLLECTION(getThis()), type);
+}
+/* }}} */
+
+/* {{{ Collection::fromArray(type, values) */
+PHP_METHOD(Collection, fromArray)
+{
+  php_driver_collection *collection;
+  php_driver_type *type;
+  zval *ztype;
+  HashTable *values;
+  zval *current;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "zh", &ztype, &values) == FAILURE)
+    return;
+
+  object_init_ex(return_value, php_driver_collection_ce);
+  collection = PHP_DRIVER_GET_COLLECTION(return_value);
+
+  if (!php_driver_collection_init_type(collection, ztype)) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  type = PHP_DRIVER_GET_TYPE(&collection->type);
+
+  if (!php_driver_validate_array(values, &type->data.collection.value_type, "value", "collections")) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  zend_hash_extend(&collection->values, zend_hash_num_elements(values), 1);
+
+  ZEND_HASH_FOREACH_VAL(values, current) {
+    ZVAL_DEREF(current);
+    Z_TRY_ADDREF_P(current);
+    zend_hash_next_index_insert(&collection->values, current);
+  } ZEND_HASH_FOREACH_END();
 }
 /* }}} */
 
@@ -281,6 +324,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, type)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_from_array, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, type)
+  ZEND_ARG_TYPE_INFO(0, values, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_value, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, value)
 ZEND_END_ARG_INFO()
@@ -318,6 +366,7 @@ ZEND_END_ARG_INFO()
 
 static zend_function_entry php_driver_collection_methods[] = {
   PHP_ME(Collection, __construct, arginfo__construct, ZEND_ACC_CTOR|ZEND_ACC_PUBLIC)
+  PHP_ME(Collection, fromArray, arginfo_from_array, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
   PHP_ME(Collection, type, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(Collection, values, arginfo_none, ZEND_ACC_PUBLIC)
 #if PHP_MAJOR_VERSION >= 8
@@ -438,17 +487,23 @@ php_driver_collection_hash_value(zval *obj)
 {
   zval *current;
   unsigned hashv = 0;
+  zend_bool nested = 0;
+  zend_ulong version = 0;
   php_driver_collection *self = PHP_DRIVER_GET_COLLECTION(obj);
 
-  if (!self->dirty) return self->hashv;
+  if (PHP_DRIVER_HASH_CACHED(self, php_driver_nested_hash_cached(&self->values, self->hash_version)))
+    return self->hashv;
 
   PHP5TO7_ZEND_HASH_FOREACH_VAL(&self->values, current) {
     hashv = php_driver_combine_hash(hashv,
                                        php_driver_value_hash(current));
+    if (php_driver_value_is_nested(current)) {
+      nested = 1;
+      version += php_driver_value_version(current);
+    }
   } PHP5TO7_ZEND_HASH_FOREACH_END(&self->values);
 
-  self->hashv = hashv;
-  self->dirty = 0;
+  PHP_DRIVER_HASH_STORE(self, hashv, nested, version);
 
   return hashv;
 }
@@ -16,6 +16,7 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "src/Database/Rows.h"
 #include "src/FutureRows.h"
 #include "util/future.h"
 #include "util/ref.h"
@@ -28,29 +29,254 @@ static void free_result(void *result)
     cass_result_free((CassResult *)result);
 }
 
-static void php_driver_rows_create(php_driver_rows *current, zval *result )
+void php_driver_rows_init(php_driver_rows *rows, php_driver_ref *page, php_driver_ref *columns, int options)
 {
-    php_driver_rows *rows;
+    rows->page = php_driver_add_ref(page);
+    rows->columns = php_driver_result_columns_get((const CassResult *)page->data, columns, options);
+    rows->count = (zend_long)cass_result_row_count((const CassResult *)page->data);
+}
+
+/* Requests the next page without waiting for it, so that it is fetched while
+ * the current page is being consumed.
+ */
+static int php_driver_rows_prefetch(php_driver_rows *self)
+{
+    php_driver_future_rows *future_rows = NULL;
+
+    if (self->result == NULL || self->next_result != NULL || !Z_ISUNDEF(self->future_next_page))
+        return SUCCESS;
+
+    ASSERT_SUCCESS_VALUE(cass_statement_set_paging_state((CassStatement *)self->statement->data,
+                                                         (const CassResult *)self->result->data),
+                         FAILURE);
+
+    object_init_ex(&self->future_next_page, php_driver_future_rows_ce);
+    future_rows = PHP_DRIVER_GET_FUTURE_ROWS(&self->future_next_page);
 
-    if (Z_ISUNDEF(current->next_rows))
+    future_rows->statement = php_driver_add_ref(self->statement);
+    future_rows->session = php_driver_add_ref(self->session);
+    future_rows->requests = php_driver_future_counter_add_ref(self->requests);
+    future_rows->columns = php_driver_add_ref(self->columns);
+    future_rows->native_options = ((const php_driver_result_columns *)self->columns->data)->options;
+    future_rows->future =
+        cass_session_execute((CassSession *)self->session->data, (CassStatement *)self->statement->data);
+    future_rows->state = php_driver_future_track(future_rows->future, self->requests);
+
+    return SUCCESS;
+}
+
+void php_driver_rows_stream(php_driver_rows *rows)
+{
+    rows->stream = 1;
+    php_driver_rows_prefetch(rows);
+}
+
+/* Replaces a consumed page of streamed rows with the next one, releasing the
+ * consumed result and prefetching the page after it.
+ */
+static int php_driver_rows_stream_advance(php_driver_rows *self)
+{
+    while (self->position >= self->count && self->result != NULL)
     {
-        if (php_driver_get_result((const CassResult *)current->next_result->data, &current->next_rows ) ==
-            FAILURE)
+        php_driver_ref *page;
+        php_driver_ref *columns;
+
+        if (self->next_result == NULL)
+        {
+            php_driver_future_rows *future_rows = NULL;
+
+            if (php_driver_rows_prefetch(self) == FAILURE)
+                return FAILURE;
+
+            if (Z_ISUNDEF(self->future_next_page) ||
+                !instanceof_function(Z_OBJCE(self->future_next_page), php_driver_future_rows_ce))
+            {
+                zend_throw_exception_ex(php_driver_runtime_exception_ce, 0, "Unable to fetch the next page.");
+                return FAILURE;
+            }
+
+            future_rows = PHP_DRIVER_GET_FUTURE_ROWS(&self->future_next_page);
+            if (php_driver_future_rows_get_result(future_rows, NULL) == FAILURE)
+                return FAILURE;
+
+            self->next_result = php_driver_add_ref(future_rows->result);
+        }
+
+        page = self->next_result;
+        self->next_result = NULL;
+        PHP5TO7_ZVAL_MAYBE_DESTROY(self->future_next_page);
+        PHP5TO7_ZVAL_MAYBE_DESTROY(self->row);
+        PHP5TO7_ZVAL_MAYBE_DESTROY(self->rows);
+
+        if (self->iterator)
+        {
+            cass_iterator_free(self->iterator);
+            self->iterator = NULL;
+        }
+
+        self->offset += self->count;
+        self->position = 0;
+
+        php_driver_del_ref(&self->page);
+        php_driver_del_ref(&self->result);
+        self->page = NULL;
+        self->result = NULL;
+
+        columns = self->columns;
+        php_driver_rows_init(self, page, columns, ((const php_driver_result_columns *)columns->data)->options);
+        php_driver_del_ref(&columns);
+        php_driver_del_ref(&page);
+
+        if (cass_result_has_more_pages((const CassResult *)self->page->data))
         {
-            PHP5TO7_ZVAL_MAYBE_DESTROY(current->next_rows);
-            return;
+            self->result = php_driver_add_ref(self->page);
+            if (php_driver_rows_prefetch(self) == FAILURE)
+                return FAILURE;
         }
     }
 
+    return SUCCESS;
+}
+
+/* Decodes every row of the current page. Rows accessed backwards would
+ * otherwise rescan the page from its first row on each access.
+ */
+static int php_driver_rows_materialize(php_driver_rows *self)
+{
+    const php_driver_result_columns *columns = (const php_driver_result_columns *)self->columns->data;
+    CassIterator *iterator;
+
+    if (self->iterator)
+    {
+        cass_iterator_free(self->iterator);
+        self->iterator = NULL;
+        self->iterator_index = -1;
+    }
+    PHP5TO7_ZVAL_MAYBE_DESTROY(self->row);
+    self->row_index = -1;
+
+    array_init_size(&self->rows, (uint32_t)self->count);
+    iterator = cass_iterator_from_result((const CassResult *)self->page->data);
+
+    while (cass_iterator_next(iterator))
+    {
+        zval row;
+
+        if (php_driver_get_row(columns, cass_iterator_get_row(iterator), self->page, &row) == FAILURE)
+        {
+            cass_iterator_free(iterator);
+            PHP5TO7_ZVAL_MAYBE_DESTROY(self->rows);
+            return FAILURE;
+        }
+        add_next_index_zval(&self->rows, &row);
+    }
+
+    cass_iterator_free(iterator);
+    return SUCCESS;
+}
+
+/* Decodes the row at the given index, reusing the forward iterator whenever
+ * rows are accessed in order. Only the most recently decoded row is kept
+ * until a row is accessed backwards, the whole page is decoded then.
+ */
+static zval *php_driver_rows_fetch(php_driver_rows *self, zend_long index)
+{
+    if (self->page == NULL || index < 0 || index >= self->count)
+        return NULL;
+
+    if (Z_TYPE(self->rows) == IS_ARRAY)
+        return zend_hash_index_find(Z_ARRVAL(self->rows), (zend_ulong)index);
+
+    if (!Z_ISUNDEF(self->row) && self->row_index == index)
+        return &self->row;
+
+    if (self->iterator != NULL && self->iterator_index > index)
+    {
+        if (php_driver_rows_materialize(self) == FAILURE)
+            return NULL;
+        return zend_hash_index_find(Z_ARRVAL(self->rows), (zend_ulong)index);
+    }
+
+    if (self->iterator == NULL)
+    {
+        self->iterator = cass_iterator_from_result((const CassResult *)self->page->data);
+        self->iterator_index = -1;
+    }
+
+    while (self->iterator_index < index)
+    {
+        if (!cass_iterator_next(self->iterator))
+            return NULL;
+        self->iterator_index++;
+    }
+
+    PHP5TO7_ZVAL_MAYBE_DESTROY(self->row);
+    if (php_driver_get_row((const php_driver_result_columns *)self->columns->data,
+                           cass_iterator_get_row(self->iterator), self->page, &self->row) == FAILURE)
+    {
+        ZVAL_UNDEF(&self->row);
+        return NULL;
+    }
+    self->row_index = index;
+
+    return &self->row;
+}
+
+/* Resolves a column name or index to its position in the result. Duplicate
+ * column names resolve to the last occurrence, like the row arrays do.
+ */
+static int php_driver_rows_column_index(php_driver_rows *self, zval *column, size_t *index)
+{
+    const php_driver_result_columns *columns = (const php_driver_result_columns *)self->columns->data;
+    size_t i;
+
+    if (Z_TYPE_P(column) == IS_LONG)
+    {
+        if (Z_LVAL_P(column) < 0 || (size_t)Z_LVAL_P(column) >= columns->count)
+        {
+            zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0, "Column index %ld is out of range",
+                                    (long)Z_LVAL_P(column));
+            return FAILURE;
+        }
+
+        *index = (size_t)Z_LVAL_P(column);
+        return SUCCESS;
+    }
+
+    if (Z_TYPE_P(column) != IS_STRING)
+    {
+        throw_invalid_argument(column, "column", "a column name or index");
+        return FAILURE;
+    }
+
+    for (i = columns->count; i > 0; i--)
+    {
+        if (zend_string_equals(columns->names[i - 1], Z_STR_P(column)))
+        {
+            *index = i - 1;
+            return SUCCESS;
+        }
+    }
+
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0, "Unknown column '%s'", Z_STRVAL_P(column));
+    return FAILURE;
+}
+
+static void php_driver_rows_create(php_driver_rows *current, zval *result )
+{
+    php_driver_rows *rows;
+
     object_init_ex(result, php_driver_rows_ce);
     rows = PHP_DRIVER_GET_ROWS(result);
 
-    ZVAL_COPY(&rows->rows, &current->next_rows);
+    php_driver_rows_init(rows, current->next_result, current->columns,
+                         ((const php_driver_result_columns *)current->columns->data)->options);
 
     if (cass_result_has_more_pages((const CassResult *)current->next_result->data))
     {
         rows->statement = php_driver_add_ref(current->statement);
         rows->session = php_driver_add_ref(current->session);
+        rows->requests = php_driver_future_counter_add_ref(current->requests);
         rows->result = php_driver_add_ref(current->next_result);
     }
 }
@@ -73,7 +299,7 @@ PHP_METHOD(Rows, count)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    RETURN_LONG(zend_hash_num_elements(Z_ARRVAL_P(&self->rows)));
+    RETURN_LONG(self->count);
 }
 
 PHP_METHOD(Rows, rewind)
@@ -85,8 +311,17 @@ PHP_METHOD(Rows, rewind)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-//    php_printf("rewind, count %d %d\n", GC_REFCOUNT(Z_ARRVAL(self->rows)), Z_ARRVAL(self->rows)->nInternalPointer);
-    zend_hash_internal_pointer_reset(Z_ARRVAL(self->rows));
+    if (self->stream && self->offset > 0)
+    {
+        zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
+                                "Cannot rewind streamed rows once their first page has been consumed.");
+        return;
+    }
+
+    self->position = 0;
+
+    if (self->stream)
+        php_driver_rows_stream_advance(self);
 }
 
 PHP_METHOD(Rows, current)
@@ -98,7 +333,7 @@ PHP_METHOD(Rows, current)
 
     php_driver_rows *self = PHP_DRIVER_GET_ROWS(getThis());
 
-    zval *entry = zend_hash_get_current_data(Z_ARRVAL(self->rows));
+    zval *entry = php_driver_rows_fetch(self, self->position);
 
     if (entry != NULL)
     {
@@ -108,8 +343,6 @@ PHP_METHOD(Rows, current)
 
 PHP_METHOD(Rows, key)
 {
-    zend_ulong num_index;
-    zend_string* str_index;
     php_driver_rows *self = NULL;
 
     if (zend_parse_parameters_none() == FAILURE)
@@ -117,9 +350,8 @@ PHP_METHOD(Rows, key)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    if (PHP5TO7_ZEND_HASH_GET_CURRENT_KEY(Z_ARRVAL(self->rows), &str_index, &num_index) ==
-        HASH_KEY_IS_LONG)
-        RETURN_LONG(num_index);
+    if (self->position < self->count)
+        RETURN_LONG(self->offset + self->position);
 }
 
 PHP_METHOD(Rows, next)
@@ -133,7 +365,11 @@ PHP_METHOD(Rows, next)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    zend_hash_move_forward(Z_ARRVAL(self->rows));
+    if (self->position < self->count)
+        self->position++;
+
+    if (self->stream)
+        php_driver_rows_stream_advance(self);
 }
 
 PHP_METHOD(Rows, valid)
@@ -145,7 +381,7 @@ PHP_METHOD(Rows, valid)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    RETURN_BOOL(zend_hash_has_more_elements(Z_ARRVAL(self->rows)) == SUCCESS);
+    RETURN_BOOL(self->position < self->count);
 }
 
 PHP_METHOD(Rows, offsetExists)
@@ -163,7 +399,14 @@ PHP_METHOD(Rows, offsetExists)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    RETURN_BOOL(zend_hash_index_exists(Z_ARRVAL(self->rows), (zend_ulong)Z_LVAL_P(offset)));
+    if (self->stream)
+    {
+        zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
+                                "Cannot access streamed rows by offset, iterate over them instead.");
+        return;
+    }
+
+    RETURN_BOOL(Z_LVAL_P(offset) < self->count);
 }
 
 PHP_METHOD(Rows, offsetGet)
@@ -181,7 +424,16 @@ PHP_METHOD(Rows, offsetGet)
     }
 
     self = PHP_DRIVER_GET_ROWS(getThis());
-    if (PHP5TO7_ZEND_HASH_INDEX_FIND(Z_ARRVAL(self->rows), Z_LVAL_P(offset), value))
+
+    if (self->stream)
+    {
+        zend_throw_exception_ex(php_driver_logic_exception_ce, 0,
+                                "Cannot access streamed rows by offset, iterate over them instead.");
+        return;
+    }
+
+    value = php_driver_rows_fetch(self, Z_LVAL_P(offset));
+    if (value != NULL)
     {
         RETURN_ZVAL(value, 1, 0);
     }
@@ -216,7 +468,7 @@ PHP_METHOD(Rows, isLastPage)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    if (self->result == NULL && Z_ISUNDEF(self->next_rows) && Z_ISUNDEF(self->future_next_page))
+    if (self->result == NULL && self->next_result == NULL && Z_ISUNDEF(self->future_next_page))
     {
         RETURN_TRUE;
     }
@@ -270,6 +522,7 @@ PHP_METHOD(Rows, nextPage)
                                                            (const CassResult *)self->result->data));
 
             future = cass_session_execute((CassSession *)self->session->data, (CassStatement *)self->statement->data);
+            php_driver_future_count(future, self->requests);
 
             if (php_driver_future_wait_timed(future, timeout ) == FAILURE)
             {
@@ -305,7 +558,6 @@ PHP_METHOD(Rows, nextPage)
 PHP_METHOD(Rows, nextPageAsync)
 {
     php_driver_rows *self = NULL;
-    php_driver_future_rows *future_rows = NULL;
 
     if (zend_parse_parameters_none() == FAILURE)
         return;
@@ -334,17 +586,8 @@ PHP_METHOD(Rows, nextPageAsync)
         return;
     }
 
-    ASSERT_SUCCESS(cass_statement_set_paging_state((CassStatement *)self->statement->data,
-                                                   (const CassResult *)self->result->data));
-
-
-    object_init_ex(&self->future_next_page, php_driver_future_rows_ce);
-    future_rows = PHP_DRIVER_GET_FUTURE_ROWS(&self->future_next_page);
-
-    future_rows->statement = php_driver_add_ref(self->statement);
-    future_rows->session = php_driver_add_ref(self->session);
-    future_rows->future =
-        cass_session_execute((CassSession *)self->session->data, (CassStatement *)self->statement->data);
+    if (php_driver_rows_prefetch(self) == FAILURE)
+        return;
 
     RETURN_ZVAL(&self->future_next_page, 1, 0);
 }
@@ -372,8 +615,7 @@ PHP_METHOD(Rows, pagingStateToken)
 
 PHP_METHOD(Rows, first)
 {
-    HashPosition pos;
-    zval *entry;
+    const CassRow *row;
     php_driver_rows *self = NULL;
 
     if (zend_parse_parameters_none() == FAILURE)
@@ -383,16 +625,123 @@ PHP_METHOD(Rows, first)
 
     self = PHP_DRIVER_GET_ROWS(getThis());
 
-    zend_hash_internal_pointer_reset_ex(Z_ARRVAL(self->rows), &pos);
-    if (PHP5TO7_ZEND_HASH_GET_CURRENT_DATA(Z_ARRVAL(self->rows), entry))
+    if (self->page == NULL)
+        return;
+
+    if (Z_TYPE(self->rows) == IS_ARRAY)
+    {
+        zval *first = zend_hash_index_find(Z_ARRVAL(self->rows), 0);
+        if (first != NULL)
+        {
+            RETURN_ZVAL(first, 1, 0);
+        }
+        return;
+    }
+
+    if (!Z_ISUNDEF(self->row) && self->row_index == 0)
+    {
+        RETURN_ZVAL(&self->row, 1, 0);
+    }
+
+    /* Decode the first row directly so the iteration cursor is left intact */
+    row = cass_result_first_row((const CassResult *)self->page->data);
+    if (row != NULL)
+    {
+        php_driver_get_row((const php_driver_result_columns *)self->columns->data, row, self->page, return_value);
+    }
+}
+
+PHP_METHOD(Rows, fetchColumn)
+{
+    zval *column;
+    size_t index;
+    php_driver_rows *self = NULL;
+
+    if (zend_parse_parameters(ZEND_NUM_ARGS(), "z", &column) == FAILURE)
+        return;
+
+    self = PHP_DRIVER_GET_ROWS(getThis());
+
+    if (self->page == NULL)
+        return;
+
+    if (php_driver_rows_column_index(self, column, &index) == FAILURE)
+        return;
+
+    php_driver_get_column((const php_driver_result_columns *)self->columns->data,
+                          (const CassResult *)self->page->data, index, self->page, return_value);
+}
+
+PHP_METHOD(Rows, toColumns)
+{
+    zval *requested = NULL;
+    const php_driver_result_columns *columns;
+    php_driver_rows *self = NULL;
+    size_t index;
+
+    if (zend_parse_parameters(ZEND_NUM_ARGS(), "|a!", &requested) == FAILURE)
+        return;
+
+    self = PHP_DRIVER_GET_ROWS(getThis());
+
+    if (self->page == NULL)
+        return;
+
+    columns = (const php_driver_result_columns *)self->columns->data;
+
+    if (requested == NULL)
     {
-        RETVAL_ZVAL(entry, 1, 0);
+        array_init_size(return_value, columns->count);
+
+        for (index = 0; index < columns->count; index++)
+        {
+            zval values;
+
+            if (php_driver_get_column(columns, (const CassResult *)self->page->data, index, self->page, &values) ==
+                FAILURE)
+            {
+                zval_ptr_dtor(return_value);
+                RETURN_NULL();
+            }
+
+            zend_symtable_update(Z_ARRVAL_P(return_value), columns->names[index], &values);
+        }
+    }
+    else
+    {
+        zval *column;
+
+        array_init_size(return_value, zend_hash_num_elements(Z_ARRVAL_P(requested)));
+
+        ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(requested), column)
+        {
+            zval values;
+
+            if (php_driver_rows_column_index(self, column, &index) == FAILURE ||
+                php_driver_get_column(columns, (const CassResult *)self->page->data, index, self->page, &values) ==
+                    FAILURE)
+            {
+                zval_ptr_dtor(return_value);
+                RETURN_NULL();
+            }
+
+            zend_symtable_update(Z_ARRVAL_P(return_value), columns->names[index], &values);
+        }
+        ZEND_HASH_FOREACH_END();
     }
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_column, 0, ZEND_RETURN_VALUE, 1)
+ZEND_ARG_INFO(0, column)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_columns, 0, ZEND_RETURN_VALUE, 0)
+ZEND_ARG_INFO(0, columns)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_offset, 0, ZEND_RETURN_VALUE, 1)
 ZEND_ARG_INFO(0, offset)
 ZEND_END_ARG_INFO()
@@ -460,7 +809,10 @@ static zend_function_entry php_driver_rows_methods[] = {
                                         PHP_ME(Rows, nextPage, arginfo_timeout, ZEND_ACC_PUBLIC)
                                             PHP_ME(Rows, nextPageAsync, arginfo_none, ZEND_ACC_PUBLIC)
                                                 PHP_ME(Rows, pagingStateToken, arginfo_none, ZEND_ACC_PUBLIC)
-                                                    PHP_ME(Rows, first, arginfo_none, ZEND_ACC_PUBLIC) PHP_FE_END};
+                                                    PHP_ME(Rows, first, arginfo_none, ZEND_ACC_PUBLIC)
+                                                        PHP_ME(Rows, fetchColumn, arginfo_column, ZEND_ACC_PUBLIC)
+                                                            PHP_ME(Rows, toColumns, arginfo_columns, ZEND_ACC_PUBLIC)
+                                                                PHP_FE_END};
 
 static zend_object_handlers php_driver_rows_handlers;
 
@@ -492,13 +844,19 @@ static void php_driver_rows_free(zend_object *object )
 {
     php_driver_rows *self = PHP5TO7_ZEND_OBJECT_GET(rows, object);
 
+    if (self->iterator)
+        cass_iterator_free(self->iterator);
+
+    php_driver_del_ref(&self->page);
+    php_driver_del_ref(&self->columns);
     php_driver_del_ref(&self->result);
     php_driver_del_ref(&self->statement);
     php_driver_del_peref(&self->session, 1);
+    php_driver_future_counter_release(&self->requests);
     php_driver_del_ref(&self->next_result);
 
+    PHP5TO7_ZVAL_MAYBE_DESTROY(self->row);
     PHP5TO7_ZVAL_MAYBE_DESTROY(self->rows);
-    PHP5TO7_ZVAL_MAYBE_DESTROY(self->next_rows);
     PHP5TO7_ZVAL_MAYBE_DESTROY(self->future_next_page);
 
     zend_object_std_dtor(&self->zendObject);
@@ -511,10 +869,20 @@ static zend_object* php_driver_rows_new(zend_class_entry *ce )
 
     self->statement = NULL;
     self->session = NULL;
+    self->requests = NULL;
     self->result = NULL;
     self->next_result = NULL;
+    self->page = NULL;
+    self->columns = NULL;
+    self->iterator = NULL;
+    self->iterator_index = -1;
+    self->count = 0;
+    self->position = 0;
+    self->row_index = -1;
+    self->stream = 0;
+    self->offset = 0;
+    ZVAL_UNDEF(&self->row);
     ZVAL_UNDEF(&self->rows);
-    ZVAL_UNDEF(&self->next_rows);
     ZVAL_UNDEF(&self->future_next_page);
 
     PHP5TO7_ZEND_OBJECT_INIT(rows, self, ce);
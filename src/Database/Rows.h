@@ -0,0 +1,24 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#include "php_driver.h"
+#include "php_driver_types.h"
+
+BEGIN_EXTERN_C()
+void php_driver_rows_init(php_driver_rows *rows, php_driver_ref *page, php_driver_ref *columns, int options);
+void php_driver_rows_stream(php_driver_rows *rows);
+END_EXTERN_C()
@@ -14,628 +14,1239 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <zend_smart_str.h>
+
 #include "DateTime/Date.h"
 #include "php_driver.h"
 #include "php_driver_globals.h"
 #include "php_driver_types.h"
+#include "src/BatchStatement.h"
+#include "src/BoundStatement.h"
+#include "src/DefaultSession.h"
+#include "src/Database/Rows.h"
 #include "src/ExecutionOptions.h"
+#include "util/bind.h"
 #include "util/collections.h"
 #include "util/future.h"
+#include "util/hash.h"
 #include "util/math.h"
+#include "util/prepared_cache.h"
 #include "util/ref.h"
 #include "util/result.h"
 BEGIN_EXTERN_C()
 zend_class_entry* php_driver_default_session_ce = NULL;
 
-#define CHECK_RESULT(rc)               \
-  do {                                 \
-    ASSERT_SUCCESS_VALUE(rc, FAILURE); \
-    return SUCCESS;                    \
-  } while (0)
-
 static void free_result(void* result) { cass_result_free((CassResult*)result); }
 
 static void free_statement(void* statement) { cass_statement_free((CassStatement*)statement); }
 
 static void free_schema(void* schema) { cass_schema_meta_free((CassSchemaMeta*)schema); }
 
-static int bind_argument_by_index(CassStatement* statement, size_t index, zval* value) {
-  if (Z_TYPE_P(value) == IS_NULL) CHECK_RESULT(cass_statement_bind_null(statement, index));
+static CassStatement* create_single(php_driver_statement* statement, HashTable* arguments,
+                                    CassConsistency consistency, long serial_consistency,
+                                    int page_size, const char* paging_state_token,
+                                    size_t paging_state_token_size, CassRetryPolicy* retry_policy,
+                                    cass_int64_t timestamp, zend_string* execution_profile) {
+  CassError rc = CASS_OK;
+  CassStatement* stmt = php_driver_create_statement(statement, arguments);
+  if (!stmt) return NULL;
 
-  if (Z_TYPE_P(value) == IS_STRING)
-    CHECK_RESULT(cass_statement_bind_string(statement, index, Z_STRVAL_P(value)));
+  rc = cass_statement_set_consistency(stmt, consistency);
 
-  if (Z_TYPE_P(value) == IS_DOUBLE)
-    CHECK_RESULT(cass_statement_bind_double(statement, index, Z_DVAL_P(value)));
+  if (rc == CASS_OK && serial_consistency >= 0)
+    rc = cass_statement_set_serial_consistency(stmt,
+                                               static_cast<CassConsistency>(serial_consistency));
 
-  if (Z_TYPE_P(value) == IS_LONG)
-    CHECK_RESULT(cass_statement_bind_int32(statement, index, Z_LVAL_P(value)));
+  if (rc == CASS_OK && page_size >= 0) rc = cass_statement_set_paging_size(stmt, page_size);
 
-  if (PHP_SCYLLADB_Z_IS_TRUE_P(value))
-    CHECK_RESULT(cass_statement_bind_bool(statement, index, cass_true));
+  if (rc == CASS_OK && paging_state_token) {
+    rc = cass_statement_set_paging_state_token(stmt, paging_state_token, paging_state_token_size);
+  }
 
-  if (PHP_SCYLLADB_Z_IS_FALSE_P(value))
-    CHECK_RESULT(cass_statement_bind_bool(statement, index, cass_false));
+  if (rc == CASS_OK && retry_policy) rc = cass_statement_set_retry_policy(stmt, retry_policy);
 
-  if (Z_TYPE_P(value) == IS_OBJECT) {
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_float_ce)) {
-      php_driver_numeric* float_number = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_float(statement, index, float_number->data.floating.value));
-    }
+  if (rc == CASS_OK) rc = cass_statement_set_timestamp(stmt, timestamp);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_bigint_ce)) {
-      php_driver_numeric* bigint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, bigint->data.bigint.value));
-    }
+  if (rc == CASS_OK && execution_profile)
+    rc = cass_statement_set_execution_profile_n(stmt, ZSTR_VAL(execution_profile),
+                                                ZSTR_LEN(execution_profile));
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_smallint_ce)) {
-      php_driver_numeric* smallint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int16(statement, index, smallint->data.smallint.value));
-    }
+  if (rc != CASS_OK) {
+    cass_statement_free(stmt);
+    zend_throw_exception_ex(exception_class(rc), rc, "%s", cass_error_desc(rc));
+    return NULL;
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tinyint_ce)) {
-      php_driver_numeric* tinyint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int8(statement, index, tinyint->data.tinyint.value));
-    }
+  return stmt;
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_scylladb_timestamp_ce)) {
-      php_scylladb_timestamp* timestamp = Z_SCYLLADB_TIMESTAMP_P(value);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, timestamp->timestamp));
-    }
+typedef struct {
+  HashTable* arguments;
+  CassConsistency consistency;
+  int page_size;
+  char* paging_state_token;
+  size_t paging_state_token_size;
+  zval* timeout;
+  long serial_consistency;
+  CassRetryPolicy* retry_policy;
+  cass_int64_t timestamp;
+  int native_options;
+  zend_string* execution_profile;
+} php_driver_session_options;
+
+/* Resolves execution options against the session defaults. Options given as
+ * an array are built into local_opts, which must outlive the resolved options.
+ */
+static int resolve_options(php_driver_session* self, zval* options,
+                           php_driver_execution_options* local_opts,
+                           php_driver_session_options* resolved) {
+  php_driver_execution_options* opts = NULL;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_scylladb_date_ce)) {
-      php_scylladb_date* date = Z_SCYLLADB_DATE_P(value);
-      CHECK_RESULT(cass_statement_bind_uint32(statement, index, date->date));
-    }
+  resolved->arguments = NULL;
+  resolved->consistency = static_cast<CassConsistency>(self->default_consistency);
+  resolved->page_size = self->default_page_size;
+  resolved->paging_state_token = NULL;
+  resolved->paging_state_token_size = 0;
+  resolved->timeout = &self->default_timeout;
+  resolved->serial_consistency = -1;
+  resolved->retry_policy = NULL;
+  resolved->timestamp = INT64_MIN;
+  resolved->native_options = 0;
+  resolved->execution_profile = NULL;
+
+  if (!options || Z_TYPE_P(options) == IS_NULL) return SUCCESS;
+
+  if (Z_TYPE_P(options) != IS_ARRAY &&
+      (Z_TYPE_P(options) != IS_OBJECT ||
+       !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
+    INVALID_ARGUMENT_VALUE(
+        options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null",
+        FAILURE);
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_scylladb_time_ce)) {
-      php_scylladb_time* time = Z_SCYLLADB_TIME_P(value);
-      CHECK_RESULT(cass_statement_bind_int64(statement, index, time->time));
+  if (Z_TYPE_P(options) == IS_OBJECT) {
+    opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
+  } else {
+    if (php_driver_execution_options_build_local_from_array(local_opts, options) == FAILURE) {
+      return FAILURE;
     }
+    opts = local_opts;
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_blob_ce)) {
-      php_driver_blob* blob = PHP_DRIVER_GET_BLOB(value);
-      CHECK_RESULT(cass_statement_bind_bytes(statement, index, blob->data, blob->size));
-    }
+  if (!Z_ISUNDEF(opts->arguments)) resolved->arguments = Z_ARRVAL(opts->arguments);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_varint_ce)) {
-      php_driver_numeric* varint = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      cass_byte_t* data = export_twos_complement(varint->data.varint.value, &size);
-      CassError rc = cass_statement_bind_bytes(statement, index, data, size);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+  /* A profile supplies its own consistency unless one is given explicitly */
+  if (opts->consistency >= 0)
+    resolved->consistency = (CassConsistency)opts->consistency;
+  else if (opts->execution_profile)
+    resolved->consistency = CASS_CONSISTENCY_UNKNOWN;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_decimal_ce)) {
-      php_driver_numeric* decimal = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      auto* data = (cass_byte_t*)export_twos_complement(decimal->data.decimal.value, &size);
-      CassError rc =
-          cass_statement_bind_decimal(statement, index, data, size, decimal->data.decimal.scale);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+  if (opts->page_size >= 0) resolved->page_size = opts->page_size;
+
+  if (opts->paging_state_token) {
+    resolved->paging_state_token = opts->paging_state_token;
+    resolved->paging_state_token_size = opts->paging_state_token_size;
+  }
+
+  if (!Z_ISUNDEF(opts->timeout)) resolved->timeout = &opts->timeout;
+
+  if (opts->serial_consistency >= 0) resolved->serial_consistency = opts->serial_consistency;
+
+  if (!Z_ISUNDEF(opts->retry_policy))
+    resolved->retry_policy =
+        (ZendCPP::ObjectFetch<php_driver_retry_policy>(&opts->retry_policy))->policy;
+
+  resolved->timestamp = opts->timestamp;
+  resolved->native_options = opts->native_options;
+  resolved->execution_profile = opts->execution_profile;
+
+  return SUCCESS;
+}
+
+/* Arguments of bound statements are only given by binding them */
+static int php_driver_session_check_bound(php_driver_session_options* opts) {
+  if (opts->arguments) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Arguments of a " PHP_DRIVER_NAMESPACE
+                            "\\BoundStatement can only be given to bind()");
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+static void php_driver_session_execute(INTERNAL_FUNCTION_PARAMETERS, zend_bool stream) {
+  zval* statement = NULL;
+  zval* options = NULL;
+  php_driver_session* self = NULL;
+  php_driver_statement* stmt = NULL;
+  php_driver_statement simple_statement;
+  php_driver_session_options opts;
+  php_driver_execution_options local_opts;
+  php_driver_statement* prepared = NULL;
+  php_driver_ref* statement_ref = NULL;
+  CassFuture* future = NULL;
+  CassStatement* single = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  if (Z_TYPE_P(statement) == IS_STRING) {
+    simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
+    simple_statement.data.simple.cql = Z_STRVAL_P(statement);
+    stmt = &simple_statement;
+  } else if (Z_TYPE_P(statement) == IS_OBJECT &&
+             instanceof_function(Z_OBJCE_P(statement), php_driver_statement_ce)) {
+    stmt = PHP_DRIVER_GET_STATEMENT(statement);
+  } else {
+    INVALID_ARGUMENT(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Statement");
+  }
+
+  if (resolve_options(self, options, &local_opts, &opts) == FAILURE) return;
+
+  switch (stmt->type) {
+    case PHP_DRIVER_SIMPLE_STATEMENT:
+    case PHP_DRIVER_PREPARED_STATEMENT:
+      single = create_single(stmt, opts.arguments, opts.consistency, opts.serial_consistency,
+                             opts.page_size, opts.paging_state_token, opts.paging_state_token_size,
+                             opts.retry_policy, opts.timestamp, opts.execution_profile);
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_uuid_interface_ce)) {
-      php_driver_uuid* uuid = PHP_DRIVER_GET_UUID(value);
-      CHECK_RESULT(cass_statement_bind_uuid(statement, index, uuid->uuid));
+      if (!single) return;
+
+      future = cass_session_execute((CassSession*)self->session->data, single);
+      if (stmt->type == PHP_DRIVER_PREPARED_STATEMENT) prepared = stmt;
+      break;
+    case PHP_DRIVER_BOUND_STATEMENT:
+      if (php_driver_session_check_bound(&opts) == FAILURE) return;
+
+      statement_ref = php_driver_bound_statement_acquire(
+          stmt, opts.consistency, opts.serial_consistency, opts.page_size, opts.paging_state_token,
+          opts.paging_state_token_size, opts.retry_policy, opts.timestamp, opts.execution_profile);
+
+      if (!statement_ref) return;
+
+      single = (CassStatement*)statement_ref->data;
+      future = cass_session_execute((CassSession*)self->session->data, single);
+      prepared = PHP_DRIVER_GET_STATEMENT(&stmt->data.bound.prepared);
+      break;
+    case PHP_DRIVER_BATCH_STATEMENT:
+      statement_ref = php_driver_batch_statement_acquire(stmt, opts.consistency, opts.retry_policy,
+                                                         opts.timestamp, opts.execution_profile);
+
+      if (!statement_ref) return;
+
+      future = cass_session_execute_batch((CassSession*)self->session->data,
+                                          (CassBatch*)statement_ref->data);
+      break;
+    default:
+      INVALID_ARGUMENT(statement,
+                       "an instance of " PHP_DRIVER_NAMESPACE
+                       "\\SimpleStatement, " PHP_DRIVER_NAMESPACE
+                       "\\PreparedStatement, " PHP_DRIVER_NAMESPACE
+                       "\\BoundStatement or " PHP_DRIVER_NAMESPACE "\\BatchStatement");
+      return;
+  }
+
+  php_driver_future_count(future, self->requests);
+
+  do {
+    const CassResult* result = NULL;
+    php_driver_rows* rows = NULL;
+    php_driver_ref* page = NULL;
+
+    if (php_driver_future_wait_timed(future, opts.timeout) == FAILURE ||
+        php_driver_future_is_error(future) == FAILURE)
+      break;
+
+    result = cass_future_get_result(future);
+    cass_future_free(future);
+
+    if (!result) {
+      zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
+                              "Future doesn't contain a result.");
+      break;
     }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_inet_ce)) {
-      php_driver_inet* inet = PHP_DRIVER_GET_INET(value);
-      CHECK_RESULT(cass_statement_bind_inet(statement, index, inet->inet));
+    object_init_ex(return_value, php_driver_rows_ce);
+    rows = PHP_DRIVER_GET_ROWS(return_value);
+
+    page = php_driver_new_ref((void*)result, free_result);
+
+    if (prepared) {
+      php_driver_rows_init(rows, page, prepared->data.prepared.columns, opts.native_options);
+      if (prepared->data.prepared.columns != rows->columns) {
+        php_driver_del_ref(&prepared->data.prepared.columns);
+        prepared->data.prepared.columns = php_driver_add_ref(rows->columns);
+      }
+    } else {
+      php_driver_rows_init(rows, page, NULL, opts.native_options);
     }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_duration_ce)) {
-      php_driver_duration* duration = PHP_DRIVER_GET_DURATION(value);
-      CHECK_RESULT(cass_statement_bind_duration(statement, index, duration->months, duration->days,
-                                                duration->nanos));
+    if (single && cass_result_has_more_pages(result)) {
+      rows->statement = statement_ref ? statement_ref : php_driver_new_ref(single, free_statement);
+      rows->result = page;
+      rows->session = php_driver_add_ref(self->session);
+      rows->requests = php_driver_future_counter_add_ref(self->requests);
+      if (stream) php_driver_rows_stream(rows);
+      return;
     }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_set_ce)) {
-      CassError rc;
-      CassCollection* collection;
-      php_driver_set* set = PHP_DRIVER_GET_SET(value);
-      if (!php_driver_collection_from_set(set, &collection)) return FAILURE;
+    php_driver_del_ref(&page);
+  } while (0);
 
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+  if (statement_ref)
+    php_driver_del_ref(&statement_ref);
+  else if (single)
+    cass_statement_free(single);
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_map_ce)) {
-      CassError rc;
-      CassCollection* collection;
-      php_driver_map* map = PHP_DRIVER_GET_MAP(value);
-      if (!php_driver_collection_from_map(map, &collection)) return FAILURE;
+PHP_METHOD(DefaultSession, execute) { php_driver_session_execute(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0); }
 
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+PHP_METHOD(DefaultSession, executeStream) {
+  php_driver_session_execute(INTERNAL_FUNCTION_PARAM_PASSTHRU, 1);
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_collection_ce)) {
-      CassError rc;
-      CassCollection* collection;
-      php_driver_collection* coll = PHP_DRIVER_GET_COLLECTION(value);
-      if (!php_driver_collection_from_collection(coll, &collection)) return FAILURE;
+struct php_driver_concurrent_queue;
 
-      rc = cass_statement_bind_collection(statement, index, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+typedef struct {
+  php_driver_concurrent_queue* queue;
+  size_t index;
+  CassFuture* future;
+  php_driver_future_counter* requests;
+  zval key;
+} php_driver_concurrent_slot;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tuple_ce)) {
-      CassError rc;
-      CassTuple* tup;
-      php_driver_tuple* tuple = PHP_DRIVER_GET_TUPLE(value);
-      if (!php_driver_tuple_from_tuple(tuple, &tup)) return FAILURE;
+/* Completions reported by the driver callbacks, consumed by the executing
+ * thread. Requests abandoned when the timeout expires keep the queue and its
+ * slots alive until their callbacks have run.
+ */
+struct php_driver_concurrent_queue {
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::deque<size_t> completed;
+  std::atomic<int> refs;
+  php_driver_concurrent_slot* slots;
+};
+
+static php_driver_concurrent_queue* php_driver_concurrent_queue_new(size_t concurrency) {
+  php_driver_concurrent_queue* queue = new php_driver_concurrent_queue();
+  size_t i;
+
+  queue->refs = 1;
+  queue->slots = new php_driver_concurrent_slot[concurrency]();
+  for (i = 0; i < concurrency; i++) {
+    queue->slots[i].queue = queue;
+    queue->slots[i].index = i;
+  }
 
-      rc = cass_statement_bind_tuple(statement, index, tup);
-      cass_tuple_free(tup);
-      CHECK_RESULT(rc);
-    }
+  return queue;
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_user_type_value_ce)) {
-      CassError rc;
-      CassUserType* ut;
-      php_driver_user_type_value* user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(value);
-      if (!php_driver_user_type_from_user_type_value(user_type_value, &ut)) return FAILURE;
+static void php_driver_concurrent_queue_release(php_driver_concurrent_queue* queue) {
+  if (--queue->refs == 0) {
+    delete[] queue->slots;
+    delete queue;
+  }
+}
 
-      rc = cass_statement_bind_user_type(statement, index, ut);
-      cass_user_type_free(ut);
-      CHECK_RESULT(rc);
-    }
+static void php_driver_concurrent_done(CassFuture* future, void* data) {
+  php_driver_concurrent_slot* slot = (php_driver_concurrent_slot*)data;
+  php_driver_concurrent_queue* queue = slot->queue;
+
+  php_driver_future_counter_done(&slot->requests);
+
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->completed.push_back(slot->index);
+    queue->ready.notify_one();
   }
 
-  return FAILURE;
+  php_driver_concurrent_queue_release(queue);
 }
 
-static int bind_argument_by_name(CassStatement* statement, const char* name, zval* value) {
-  if (Z_TYPE_P(value) == IS_NULL) {
-    CHECK_RESULT(cass_statement_bind_null_by_name(statement, name));
+static void php_driver_concurrent_capture(zval* errors, zval* key) {
+  zval exception;
+
+  ZVAL_OBJ(&exception, EG(exception));
+  GC_ADDREF(EG(exception));
+  zend_clear_exception();
+
+  array_set_zval_key(Z_ARRVAL_P(errors), key, &exception);
+  zval_ptr_dtor(&exception);
+}
+
+/* Walks the argument rows of an array or a Traversable */
+typedef struct {
+  HashTable* array;
+  HashPosition position;
+  zend_object_iterator* iterator;
+  zend_long index;
+} php_driver_concurrent_cursor;
+
+static int php_driver_concurrent_cursor_init(php_driver_concurrent_cursor* cursor,
+                                             zval* arguments) {
+  cursor->array = NULL;
+  cursor->iterator = NULL;
+  cursor->index = 0;
+
+  if (Z_TYPE_P(arguments) == IS_ARRAY) {
+    cursor->array = Z_ARRVAL_P(arguments);
+    zend_hash_internal_pointer_reset_ex(cursor->array, &cursor->position);
+    return SUCCESS;
   }
 
-  if (Z_TYPE_P(value) == IS_STRING)
-    CHECK_RESULT(cass_statement_bind_string_by_name(statement, name, Z_STRVAL_P(value)));
+  cursor->iterator = Z_OBJCE_P(arguments)->get_iterator(Z_OBJCE_P(arguments), arguments, 0);
+  if (!cursor->iterator) return FAILURE;
+  if (cursor->iterator->funcs->rewind) cursor->iterator->funcs->rewind(cursor->iterator);
+  if (EG(exception)) {
+    zend_iterator_dtor(cursor->iterator);
+    return FAILURE;
+  }
 
-  if (Z_TYPE_P(value) == IS_DOUBLE)
-    CHECK_RESULT(cass_statement_bind_double_by_name(statement, name, Z_DVAL_P(value)));
+  return SUCCESS;
+}
 
-  if (Z_TYPE_P(value) == IS_LONG)
-    CHECK_RESULT(cass_statement_bind_int32_by_name(statement, name, Z_LVAL_P(value)));
+/* Returns the next row and sets its key, or NULL once exhausted or when iterating throws */
+static zval* php_driver_concurrent_cursor_next(php_driver_concurrent_cursor* cursor, zval* key) {
+  zval* row;
 
-  if (PHP_SCYLLADB_Z_IS_TRUE_P(value))
-    CHECK_RESULT(cass_statement_bind_bool_by_name(statement, name, cass_true));
+  if (cursor->iterator) {
+    if (cursor->index > 0) cursor->iterator->funcs->move_forward(cursor->iterator);
+    if (EG(exception) || cursor->iterator->funcs->valid(cursor->iterator) == FAILURE) return NULL;
 
-  if (PHP_SCYLLADB_Z_IS_FALSE_P(value))
-    CHECK_RESULT(cass_statement_bind_bool_by_name(statement, name, cass_false));
+    row = cursor->iterator->funcs->get_current_data(cursor->iterator);
+    if (EG(exception) || !row) return NULL;
 
-  if (Z_TYPE_P(value) == IS_OBJECT) {
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_float_ce)) {
-      php_driver_numeric* float_number = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(
-          cass_statement_bind_float_by_name(statement, name, float_number->data.floating.value));
+    if (cursor->iterator->funcs->get_current_key) {
+      cursor->iterator->funcs->get_current_key(cursor->iterator, key);
+      if (EG(exception)) {
+        zval_ptr_dtor(key);
+        return NULL;
+      }
+    } else {
+      ZVAL_LONG(key, cursor->index);
     }
+  } else {
+    row = zend_hash_get_current_data_ex(cursor->array, &cursor->position);
+    if (!row) return NULL;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_bigint_ce)) {
-      php_driver_numeric* bigint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, bigint->data.bigint.value));
-    }
+    zend_hash_get_current_key_zval_ex(cursor->array, key, &cursor->position);
+    zend_hash_move_forward_ex(cursor->array, &cursor->position);
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_smallint_ce)) {
-      php_driver_numeric* smallint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(
-          cass_statement_bind_int16_by_name(statement, name, smallint->data.smallint.value));
-    }
+  cursor->index++;
+  ZVAL_DEREF(row);
+  return row;
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tinyint_ce)) {
-      php_driver_numeric* tinyint = PHP_DRIVER_GET_NUMERIC(value);
-      CHECK_RESULT(cass_statement_bind_int8_by_name(statement, name, tinyint->data.tinyint.value));
-    }
+static void php_driver_concurrent_cursor_destroy(php_driver_concurrent_cursor* cursor) {
+  if (cursor->iterator) zend_iterator_dtor(cursor->iterator);
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_scylladb_timestamp_ce)) {
-      php_scylladb_timestamp* timestamp = Z_SCYLLADB_TIMESTAMP_P(value);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, timestamp->timestamp));
-    }
+/* Slots are allocated up front, so the requested concurrency is capped by
+ * the number of rows of an array and by a fixed maximum for a Traversable.
+ */
+#define PHP_DRIVER_CONCURRENCY_MAX 4096
 
-    if (instanceof_function(Z_OBJCE_P(value), php_scylladb_date_ce)) {
-      php_scylladb_date* date = Z_SCYLLADB_DATE_P(value);
-      CHECK_RESULT(cass_statement_bind_uint32_by_name(statement, name, date->date));
-    }
+static size_t php_driver_concurrent_limit(zval* arguments, zend_long concurrency) {
+  size_t limit = PHP_DRIVER_CONCURRENCY_MAX;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_scylladb_time_ce)) {
-      php_scylladb_time* time = Z_SCYLLADB_TIME_P(value);
-      CHECK_RESULT(cass_statement_bind_int64_by_name(statement, name, time->time));
-    }
+  if (Z_TYPE_P(arguments) == IS_ARRAY) {
+    limit = MAX(zend_hash_num_elements(Z_ARRVAL_P(arguments)), 1);
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_blob_ce)) {
-      php_driver_blob* blob = PHP_DRIVER_GET_BLOB(value);
-      CHECK_RESULT(cass_statement_bind_bytes_by_name(statement, name, blob->data, blob->size));
-    }
+  return MIN((zend_ulong)concurrency, limit);
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_varint_ce)) {
-      php_driver_numeric* varint = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      auto* data = (cass_byte_t*)export_twos_complement(varint->data.varint.value, &size);
-      CassError rc = cass_statement_bind_bytes_by_name(statement, name, data, size);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+static void php_driver_concurrent_start(php_driver_concurrent_slot* slot, CassFuture* future,
+                                        php_driver_future_counter* requests) {
+  slot->future = future;
+  slot->requests = php_driver_future_counter_start(requests);
+  slot->queue->refs++;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_decimal_ce)) {
-      php_driver_numeric* decimal = PHP_DRIVER_GET_NUMERIC(value);
-      size_t size;
-      cass_byte_t* data = (cass_byte_t*)export_twos_complement(decimal->data.decimal.value, &size);
-      CassError rc = cass_statement_bind_decimal_by_name(statement, name, data, size,
-                                                         decimal->data.decimal.scale);
-      free(data);
-      CHECK_RESULT(rc);
-    }
+  if (cass_future_set_callback(slot->future, php_driver_concurrent_done, slot) != CASS_OK) {
+    cass_future_wait(slot->future);
+    php_driver_concurrent_done(slot->future, slot);
+  }
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_uuid_interface_ce)) {
-      php_driver_uuid* uuid = PHP_DRIVER_GET_UUID(value);
-      CHECK_RESULT(cass_statement_bind_uuid_by_name(statement, name, uuid->uuid));
-    }
+/* Blocks until a request completes and returns its slot, or NULL once the
+ * deadline has passed when there is a timeout
+ */
+static php_driver_concurrent_slot* php_driver_concurrent_wait(
+    php_driver_concurrent_queue* queue, cass_duration_t timeout_us,
+    std::chrono::steady_clock::time_point deadline) {
+  size_t index;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  auto completed = [queue] { return !queue->completed.empty(); };
+
+  if (timeout_us == 0)
+    queue->ready.wait(lock, completed);
+  else if (!queue->ready.wait_until(lock, deadline, completed))
+    return NULL;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_inet_ce)) {
-      php_driver_inet* inet = PHP_DRIVER_GET_INET(value);
-      CHECK_RESULT(cass_statement_bind_inet_by_name(statement, name, inet->inet));
-    }
+  index = queue->completed.front();
+  queue->completed.pop_front();
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_duration_ce)) {
-      php_driver_duration* duration = PHP_DRIVER_GET_DURATION(value);
-      CHECK_RESULT(cass_statement_bind_duration_by_name(statement, name, duration->months,
-                                                        duration->days, duration->nanos));
-    }
+  return &queue->slots[index];
+}
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_set_ce)) {
-      CassError rc;
-      CassCollection* collection;
-      php_driver_set* set = PHP_DRIVER_GET_SET(value);
-      if (!php_driver_collection_from_set(set, &collection)) return FAILURE;
+/* Frees the requests still in flight when the timeout expires, their
+ * callbacks release the queue once they run
+ */
+static void php_driver_concurrent_abandon(php_driver_concurrent_queue* queue, size_t concurrency,
+                                          zend_bool aborted, cass_duration_t timeout_us) {
+  size_t i;
 
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+  for (i = 0; i < concurrency; i++) {
+    php_driver_concurrent_slot* slot = &queue->slots[i];
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_map_ce)) {
-      CassError rc;
-      CassCollection* collection;
-      php_driver_map* map = PHP_DRIVER_GET_MAP(value);
-      if (!php_driver_collection_from_map(map, &collection)) return FAILURE;
+    if (!slot->future) continue;
 
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+    cass_future_free(slot->future);
+    slot->future = NULL;
+    zval_ptr_dtor(&slot->key);
+  }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_collection_ce)) {
-      CassError rc;
-      CassCollection* collection;
-      php_driver_collection* coll = PHP_DRIVER_GET_COLLECTION(value);
-      if (!php_driver_collection_from_collection(coll, &collection)) return FAILURE;
+  /* An exception that stopped sending more requests is reported instead */
+  if (!aborted)
+    zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
+                            "Requests haven't completed within %f seconds",
+                            timeout_us / 1000000.0);
+}
 
-      rc = cass_statement_bind_collection_by_name(statement, name, collection);
-      cass_collection_free(collection);
-      CHECK_RESULT(rc);
-    }
+PHP_METHOD(DefaultSession, executeConcurrent) {
+  zval* statement = NULL;
+  zval* arguments = NULL;
+  zend_long concurrency = 100;
+  zval* options = NULL;
+  php_driver_session* self = NULL;
+  php_driver_statement* stmt = NULL;
+  php_driver_statement simple_statement;
+  php_driver_session_options opts;
+  php_driver_execution_options local_opts;
+  php_driver_concurrent_queue* queue;
+  size_t* free_slots;
+  size_t free_count;
+  size_t in_flight = 0;
+  zend_long success = 0;
+  zend_long failure = 0;
+  zend_bool exhausted = 0;
+  zend_bool aborted = 0;
+  zend_bool timed_out = 0;
+  cass_duration_t timeout_us;
+  std::chrono::steady_clock::time_point deadline;
+  php_driver_concurrent_cursor cursor;
+  zval errors;
+  size_t i;
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_tuple_ce)) {
-      CassError rc;
-      CassTuple* tup;
-      php_driver_tuple* tuple = PHP_DRIVER_GET_TUPLE(value);
-      if (!php_driver_tuple_from_tuple(tuple, &tup)) return FAILURE;
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "zz|lz", &statement, &arguments, &concurrency,
+                            &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  if (Z_TYPE_P(statement) == IS_STRING) {
+    simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
+    simple_statement.data.simple.cql = Z_STRVAL_P(statement);
+    stmt = &simple_statement;
+  } else if (Z_TYPE_P(statement) == IS_OBJECT &&
+             (instanceof_function(Z_OBJCE_P(statement), php_driver_simple_statement_ce) ||
+              instanceof_function(Z_OBJCE_P(statement), php_driver_prepared_statement_ce))) {
+    stmt = PHP_DRIVER_GET_STATEMENT(statement);
+  } else {
+    INVALID_ARGUMENT(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE
+                                "\\SimpleStatement or " PHP_DRIVER_NAMESPACE
+                                "\\PreparedStatement");
+  }
 
-      rc = cass_statement_bind_tuple_by_name(statement, name, tup);
-      cass_tuple_free(tup);
-      CHECK_RESULT(rc);
+  if (Z_TYPE_P(arguments) != IS_ARRAY &&
+      (Z_TYPE_P(arguments) != IS_OBJECT ||
+       !instanceof_function(Z_OBJCE_P(arguments), zend_ce_traversable))) {
+    INVALID_ARGUMENT(arguments, "an array or an instance of Traversable");
+  }
+
+  if (concurrency <= 0) {
+    zval value;
+    ZVAL_LONG(&value, concurrency);
+    throw_invalid_argument(&value, "concurrency", "a positive integer");
+    return;
+  }
+
+  if (resolve_options(self, options, &local_opts, &opts) == FAILURE ||
+      php_driver_future_parse_timeout(opts.timeout, &timeout_us) == FAILURE)
+    return;
+
+  /* The timeout bounds the whole call rather than each request */
+  deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+
+  if (php_driver_concurrent_cursor_init(&cursor, arguments) == FAILURE) return;
+
+  concurrency = (zend_long)php_driver_concurrent_limit(arguments, concurrency);
+  queue = php_driver_concurrent_queue_new((size_t)concurrency);
+  free_slots = (size_t*)ecalloc(concurrency, sizeof(size_t));
+  for (i = 0; i < (size_t)concurrency; i++) {
+    free_slots[i] = (size_t)concurrency - i - 1;
+  }
+  free_count = (size_t)concurrency;
+
+  array_init(&errors);
+
+  while (1) {
+    /* Keep the requested number of requests in flight */
+    while (!exhausted && !aborted && in_flight < (size_t)concurrency) {
+      php_driver_concurrent_slot* slot;
+      CassStatement* single;
+      zval* row;
+      zval key;
+
+      row = php_driver_concurrent_cursor_next(&cursor, &key);
+      if (!row) {
+        exhausted = 1;
+        aborted = EG(exception) != NULL;
+        break;
+      }
+
+      if (Z_TYPE_P(row) != IS_ARRAY) {
+        zval_ptr_dtor(&key);
+        throw_invalid_argument(row, "arguments", "an array of arguments for each row");
+        aborted = 1;
+        break;
+      }
+
+      single = create_single(stmt, Z_ARRVAL_P(row), opts.consistency, opts.serial_consistency,
+                             opts.page_size, NULL, 0, opts.retry_policy, opts.timestamp,
+                             opts.execution_profile);
+
+      /* Rows that can't be bound are reported like failed requests */
+      if (!single) {
+        failure++;
+        if (EG(exception)) php_driver_concurrent_capture(&errors, &key);
+        zval_ptr_dtor(&key);
+        continue;
+      }
+
+      slot = &queue->slots[free_slots[--free_count]];
+      ZVAL_COPY_VALUE(&slot->key, &key);
+      php_driver_concurrent_start(
+          slot, cass_session_execute((CassSession*)self->session->data, single), self->requests);
+      cass_statement_free(single);
+      in_flight++;
     }
 
-    if (instanceof_function(Z_OBJCE_P(value), php_driver_user_type_value_ce)) {
+    if (in_flight == 0) break;
+
+    {
+      php_driver_concurrent_slot* slot = php_driver_concurrent_wait(queue, timeout_us, deadline);
       CassError rc;
-      CassUserType* ut;
-      php_driver_user_type_value* user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(value);
-      if (!php_driver_user_type_from_user_type_value(user_type_value, &ut)) return FAILURE;
 
-      rc = cass_statement_bind_user_type_by_name(statement, name, ut);
-      cass_user_type_free(ut);
-      CHECK_RESULT(rc);
+      if (!slot) {
+        php_driver_concurrent_abandon(queue, (size_t)concurrency, aborted, timeout_us);
+        timed_out = 1;
+        break;
+      }
+
+      rc = cass_future_error_code(slot->future);
+
+      if (rc == CASS_OK) {
+        success++;
+      } else {
+        failure++;
+        if (!aborted && php_driver_future_is_error(slot->future) == FAILURE)
+          php_driver_concurrent_capture(&errors, &slot->key);
+      }
+
+      cass_future_free(slot->future);
+      slot->future = NULL;
+      zval_ptr_dtor(&slot->key);
+      free_slots[free_count++] = slot->index;
+      in_flight--;
     }
   }
 
-  return FAILURE;
+  php_driver_concurrent_cursor_destroy(&cursor);
+  efree(free_slots);
+  php_driver_concurrent_queue_release(queue);
+
+  if (aborted || timed_out) {
+    zval_ptr_dtor(&errors);
+    return;
+  }
+
+  array_init(return_value);
+  add_assoc_long(return_value, "success", success);
+  add_assoc_long(return_value, "failure", failure);
+  add_assoc_zval(return_value, "errors", &errors);
 }
 
-static int bind_arguments(CassStatement* statement, HashTable* arguments) {
-  int rc = SUCCESS;
+static void php_driver_concurrent_capture_all(zval* errors, zval* keys) {
+  zval exception;
+  zval* key;
 
-  zval* current;
-  ulong num_key;
+  ZVAL_OBJ(&exception, EG(exception));
+  GC_ADDREF(EG(exception));
+  zend_clear_exception();
 
-#if PHP_MAJOR_VERSION >= 7
-  zend_string* key;
-  ZEND_HASH_FOREACH_KEY_VAL(arguments, num_key, key, current) {
-    if (key) {
-      rc = bind_argument_by_name(statement, key->val, current);
-#else
-  char* str_key;
-  uint str_len;
-  PHP5TO7_ZEND_HASH_FOREACH_KEY_VAL(arguments, num_key, str_key, str_len, current) {
-    if (str_key) {
-      rc = bind_argument_by_name(statement, str_key, current);
-#endif
-    } else {
-      rc = bind_argument_by_index(statement, num_key, current);
-    }
-    if (rc == FAILURE) break;
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(keys), key) {
+    array_set_zval_key(Z_ARRVAL_P(errors), key, &exception);
   }
-  PHP5TO7_ZEND_HASH_FOREACH_END(arguments);
+  ZEND_HASH_FOREACH_END();
+  zval_ptr_dtor(&exception);
+}
+
+/* Argument of the rows given to executeGrouped() that is part of the partition key */
+typedef struct {
+  zend_string* name;
+  zend_long index;
+  CassValueType type;
+} php_driver_grouped_column;
 
-  return rc;
+/* Rows of a single partition waiting to be sent together. Partitions whose
+ * key values share a hash are chained.
+ */
+typedef struct php_driver_grouped_batch_ {
+  CassBatch* batch;
+  zval keys;
+  zval values;
+  zend_ulong hash;
+  struct php_driver_grouped_batch_* next;
+} php_driver_grouped_batch;
+
+static void php_driver_grouped_columns_free(php_driver_grouped_column* columns, size_t count) {
+  size_t i;
+
+  for (i = 0; i < count; i++) {
+    if (columns[i].name) zend_string_release(columns[i].name);
+  }
+  efree(columns);
 }
 
-static CassStatement* create_statement(php_driver_statement* statement, HashTable* arguments) {
-  CassStatement* stmt;
-  uint32_t count;
+/* Resolves the partition key from argument names or positions, or from the
+ * partition key columns of a table.
+ */
+static php_driver_grouped_column* php_driver_grouped_columns(php_driver_statement* prepared,
+                                                             zval* partition_key, size_t* count) {
+  php_driver_grouped_column* columns;
+  zval names;
+  zval* current;
+  size_t i = 0;
 
-  switch (statement->type) {
-    case PHP_DRIVER_SIMPLE_STATEMENT:
-      count = 0;
+  if (Z_TYPE_P(partition_key) == IS_OBJECT &&
+      instanceof_function(Z_OBJCE_P(partition_key), php_driver_table_ce)) {
+    zval table_columns;
 
-      if (arguments) count = zend_hash_num_elements(arguments);
+    zend_call_method_with_0_params(Z_OBJ_P(partition_key), Z_OBJCE_P(partition_key), NULL,
+                                   "partitionkey", &table_columns);
+    if (EG(exception)) return NULL;
 
-      stmt = cass_statement_new(statement->data.simple.cql, count);
-      break;
-    case PHP_DRIVER_PREPARED_STATEMENT:
-      stmt = cass_prepared_bind(statement->data.prepared.prepared);
-      break;
-    default:
-      zend_throw_exception_ex(php_driver_runtime_exception_ce, 0, "Unsupported statement type.");
+    array_init(&names);
+    if (Z_TYPE(table_columns) == IS_ARRAY) {
+      ZEND_HASH_FOREACH_VAL(Z_ARRVAL(table_columns), current) {
+        zval name;
+
+        if (Z_TYPE_P(current) != IS_OBJECT) continue;
+
+        zend_call_method_with_0_params(Z_OBJ_P(current), Z_OBJCE_P(current), NULL, "name", &name);
+        if (EG(exception)) break;
+        add_next_index_zval(&names, &name);
+      }
+      ZEND_HASH_FOREACH_END();
+    }
+    zval_ptr_dtor(&table_columns);
+
+    if (EG(exception)) {
+      zval_ptr_dtor(&names);
       return NULL;
+    }
+  } else if (Z_TYPE_P(partition_key) == IS_ARRAY) {
+    ZVAL_COPY(&names, partition_key);
+  } else {
+    INVALID_ARGUMENT_VALUE(partition_key,
+                           "an array of argument names or positions or an instance of " PHP_DRIVER_NAMESPACE
+                           "\\Table",
+                           NULL);
   }
 
-  if (arguments && bind_arguments(stmt, arguments) == FAILURE) {
-    cass_statement_free(stmt);
+  *count = zend_hash_num_elements(Z_ARRVAL(names));
+  if (*count == 0) {
+    zval_ptr_dtor(&names);
+    throw_invalid_argument(partition_key, "partitionKey", "at least one partition key column");
     return NULL;
   }
 
-  return stmt;
+  columns = (php_driver_grouped_column*)ecalloc(*count, sizeof(php_driver_grouped_column));
+
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL(names), current) {
+    const CassDataType* data_type = NULL;
+
+    if (Z_TYPE_P(current) == IS_LONG && Z_LVAL_P(current) >= 0) {
+      columns[i].index = Z_LVAL_P(current);
+    } else if (Z_TYPE_P(current) == IS_STRING) {
+      columns[i].name = zend_string_copy(Z_STR_P(current));
+      columns[i].index = php_driver_bind_parameter_index(prepared, Z_STR_P(current));
+    } else {
+      throw_invalid_argument(current, "partitionKey", "an argument name or position");
+      break;
+    }
+
+    if (columns[i].index >= 0)
+      data_type = cass_prepared_parameter_data_type(prepared->data.prepared.prepared,
+                                                    (size_t)columns[i].index);
+    columns[i].type = data_type ? cass_data_type_type(data_type) : CASS_VALUE_TYPE_UNKNOWN;
+    i++;
+  }
+  ZEND_HASH_FOREACH_END();
+  zval_ptr_dtor(&names);
+
+  if (i < *count) {
+    php_driver_grouped_columns_free(columns, i);
+    return NULL;
+  }
+
+  return columns;
 }
 
-static CassBatch* create_batch(php_driver_statement* batch, CassConsistency consistency,
-                               CassRetryPolicy* retry_policy, cass_int64_t timestamp) {
-  CassBatch* cass_batch = cass_batch_new(batch->data.batch.type);
-  CassError rc = CASS_OK;
+/* Converts a partition key argument to the form it is bound with, so that
+ * equal values given as different PHP types (e.g. 1 and new Bigint(1))
+ * identify the same partition.
+ */
+static void php_driver_grouped_value(zval* value, CassValueType type, zval* out) {
+  if (Z_TYPE_P(value) == IS_OBJECT) {
+    zend_class_entry* ce = Z_OBJCE_P(value);
 
-  zval* current;
-  PHP5TO7_ZEND_HASH_FOREACH_VAL(&batch->data.batch.statements, current) {
-    php_driver_statement* statement;
-    php_driver_statement simple_statement;
-    HashTable* arguments;
-    CassStatement* stmt;
-
-#if PHP_MAJOR_VERSION >= 7
-    php_driver_batch_statement_entry* batch_statement_entry =
-        (php_driver_batch_statement_entry*)Z_PTR_P(current);
-#else
-    php_driver_batch_statement_entry* batch_statement_entry =
-        *((php_driver_batch_statement_entry**)current);
+#if SIZEOF_ZEND_LONG == 8
+    if (ce == php_driver_bigint_ce) {
+      ZVAL_LONG(out, PHP_DRIVER_GET_NUMERIC(value)->data.bigint.value);
+      return;
+    }
+    if (ce == php_scylladb_timestamp_ce) {
+      ZVAL_LONG(out, Z_SCYLLADB_TIMESTAMP_P(value)->timestamp);
+      return;
+    }
 #endif
+    if (ce == php_driver_smallint_ce) {
+      ZVAL_LONG(out, PHP_DRIVER_GET_NUMERIC(value)->data.smallint.value);
+      return;
+    }
+    if (ce == php_driver_tinyint_ce) {
+      ZVAL_LONG(out, PHP_DRIVER_GET_NUMERIC(value)->data.tinyint.value);
+      return;
+    }
+    if (ce == php_driver_float_ce) {
+      ZVAL_DOUBLE(out, PHP_DRIVER_GET_NUMERIC(value)->data.floating.value);
+      return;
+    }
+    if (ce == php_driver_blob_ce) {
+      php_driver_blob* blob = PHP_DRIVER_GET_BLOB(value);
+      ZVAL_STRINGL(out, (const char*)blob->data, blob->size);
+      return;
+    }
+    if (ce == php_driver_uuid_ce || ce == php_driver_timeuuid_ce) {
+      char string[CASS_UUID_STRING_LENGTH];
+      cass_uuid_string(PHP_DRIVER_GET_UUID(value)->uuid, string);
+      ZVAL_STRING(out, string);
+      return;
+    }
+    if (ce == php_driver_inet_ce) {
+      char string[CASS_INET_STRING_LENGTH];
+      cass_inet_string(PHP_DRIVER_GET_INET(value)->inet, string);
+      ZVAL_STRING(out, string);
+      return;
+    }
+  } else if (Z_TYPE_P(value) == IS_STRING) {
+    if (type == CASS_VALUE_TYPE_UUID || type == CASS_VALUE_TYPE_TIMEUUID) {
+      CassUuid uuid;
+      char string[CASS_UUID_STRING_LENGTH];
+
+      if (cass_uuid_from_string_n(Z_STRVAL_P(value), Z_STRLEN_P(value), &uuid) == CASS_OK) {
+        cass_uuid_string(uuid, string);
+        ZVAL_STRING(out, string);
+        return;
+      }
+    } else if (type == CASS_VALUE_TYPE_INET) {
+      CassInet inet;
+      char string[CASS_INET_STRING_LENGTH];
 
-    if (Z_TYPE(batch_statement_entry->statement) == IS_STRING) {
-      simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
-      simple_statement.data.simple.cql = Z_STRVAL(batch_statement_entry->statement);
-      statement = &simple_statement;
-    } else {
-      statement = PHP_DRIVER_GET_STATEMENT(&batch_statement_entry->statement);
+      if (cass_inet_from_string_n(Z_STRVAL_P(value), Z_STRLEN_P(value), &inet) == CASS_OK) {
+        cass_inet_string(inet, string);
+        ZVAL_STRING(out, string);
+        return;
+      }
+    }
+  } else if (Z_TYPE_P(value) == IS_LONG) {
+    if (type == CASS_VALUE_TYPE_FLOAT || type == CASS_VALUE_TYPE_DOUBLE) {
+      ZVAL_DOUBLE(out, (double)Z_LVAL_P(value));
+      return;
     }
+  } else if (Z_TYPE_P(value) == IS_DOUBLE && type == CASS_VALUE_TYPE_FLOAT) {
+    ZVAL_DOUBLE(out, (cass_float_t)Z_DVAL_P(value));
+    return;
+  }
 
-    arguments = !Z_ISUNDEF(batch_statement_entry->arguments)
-                    ? Z_ARRVAL_P(&batch_statement_entry->arguments)
-                    : NULL;
+  ZVAL_COPY(out, value);
+}
 
-    stmt = create_statement(statement, arguments);
-    if (!stmt) {
-      cass_batch_free(cass_batch);
-      return NULL;
+/* Collects the partition key arguments of a row. Value objects without a
+ * string form (e.g. tuples and user types) are compared with the same
+ * hash and comparison as set and map entries.
+ */
+static int php_driver_grouped_values(php_driver_grouped_column* columns, size_t count,
+                                     HashTable* row, zval* values, zend_ulong* hash) {
+  size_t i;
+
+  array_init_size(values, count);
+  *hash = 0;
+
+  for (i = 0; i < count; i++) {
+    zval* value = NULL;
+    zval normalized;
+
+    if (columns[i].name) value = zend_hash_find(row, columns[i].name);
+    if (!value && columns[i].index >= 0) value = zend_hash_index_find(row, columns[i].index);
+
+    if (!value) {
+      zval_ptr_dtor(values);
+      if (columns[i].name) {
+        zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                "Missing partition key argument \"%s\"", ZSTR_VAL(columns[i].name));
+      } else {
+        zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                "Missing partition key argument " ZEND_LONG_FMT, columns[i].index);
+      }
+      return FAILURE;
     }
-    cass_batch_add_statement(cass_batch, stmt);
-    cass_statement_free(stmt);
+
+    ZVAL_DEREF(value);
+    if (Z_TYPE_P(value) == IS_ARRAY ||
+        (Z_TYPE_P(value) == IS_OBJECT &&
+         !instanceof_function(Z_OBJCE_P(value), php_driver_value_ce))) {
+      zval_ptr_dtor(values);
+      throw_invalid_argument(value, "partition key argument", "a scalar or a value object");
+      return FAILURE;
+    }
+
+    php_driver_grouped_value(value, columns[i].type, &normalized);
+    *hash = php_driver_combine_hash(*hash, php_driver_value_hash(&normalized));
+    add_next_index_zval(values, &normalized);
   }
-  PHP5TO7_ZEND_HASH_FOREACH_END(&batch->data.batch.statements);
 
-  rc = cass_batch_set_consistency(cass_batch, consistency);
-  ASSERT_SUCCESS_BLOCK(rc, cass_batch_free(cass_batch); return NULL;);
+  return SUCCESS;
+}
+
+static zend_bool php_driver_grouped_values_equal(zval* values1, zval* values2) {
+  zval* value1;
+  uint32_t i = 0;
 
-  rc = cass_batch_set_retry_policy(cass_batch, retry_policy);
-  ASSERT_SUCCESS_BLOCK(rc, cass_batch_free(cass_batch); return NULL;);
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(values1), value1) {
+    zval* value2 = zend_hash_index_find(Z_ARRVAL_P(values2), i++);
 
-  rc = cass_batch_set_timestamp(cass_batch, timestamp);
-  ASSERT_SUCCESS_BLOCK(rc, cass_batch_free(cass_batch); return NULL;);
+    if (!value2 || php_driver_value_compare(value1, value2) != 0) return 0;
+  }
+  ZEND_HASH_FOREACH_END();
 
-  return cass_batch;
+  return 1;
 }
 
-static CassStatement* create_single(php_driver_statement* statement, HashTable* arguments,
-                                    CassConsistency consistency, long serial_consistency,
-                                    int page_size, const char* paging_state_token,
-                                    size_t paging_state_token_size, CassRetryPolicy* retry_policy,
-                                    cass_int64_t timestamp) {
-  CassError rc = CASS_OK;
-  CassStatement* stmt = create_statement(statement, arguments);
-  if (!stmt) return NULL;
+static void php_driver_grouped_unlink(HashTable* groups, php_driver_grouped_batch* group) {
+  php_driver_grouped_batch* current =
+      (php_driver_grouped_batch*)zend_hash_index_find_ptr(groups, group->hash);
 
-  rc = cass_statement_set_consistency(stmt, consistency);
+  if (current == group) {
+    if (group->next)
+      zend_hash_index_update_ptr(groups, group->hash, group->next);
+    else
+      zend_hash_index_del(groups, group->hash);
+    return;
+  }
 
-  if (rc == CASS_OK && serial_consistency >= 0)
-    rc = cass_statement_set_serial_consistency(stmt,
-                                               static_cast<CassConsistency>(serial_consistency));
+  while (current->next != group) current = current->next;
+  current->next = group->next;
+}
 
-  if (rc == CASS_OK && page_size >= 0) rc = cass_statement_set_paging_size(stmt, page_size);
+static CassBatch* php_driver_grouped_batch_new(php_driver_session_options* opts) {
+  CassBatch* batch = cass_batch_new(CASS_BATCH_TYPE_UNLOGGED);
+  CassError rc = cass_batch_set_consistency(batch, opts->consistency);
+
+  if (rc == CASS_OK && opts->serial_consistency >= 0)
+    rc = cass_batch_set_serial_consistency(batch,
+                                           static_cast<CassConsistency>(opts->serial_consistency));
 
-  if (rc == CASS_OK && paging_state_token) {
-    rc = cass_statement_set_paging_state_token(stmt, paging_state_token, paging_state_token_size);
-  }
+  if (rc == CASS_OK && opts->retry_policy)
+    rc = cass_batch_set_retry_policy(batch, opts->retry_policy);
 
-  if (rc == CASS_OK && retry_policy) rc = cass_statement_set_retry_policy(stmt, retry_policy);
+  if (rc == CASS_OK) rc = cass_batch_set_timestamp(batch, opts->timestamp);
 
-  if (rc == CASS_OK) rc = cass_statement_set_timestamp(stmt, timestamp);
+  if (rc == CASS_OK && opts->execution_profile)
+    rc = cass_batch_set_execution_profile_n(batch, ZSTR_VAL(opts->execution_profile),
+                                            ZSTR_LEN(opts->execution_profile));
 
   if (rc != CASS_OK) {
-    cass_statement_free(stmt);
+    cass_batch_free(batch);
     zend_throw_exception_ex(exception_class(rc), rc, "%s", cass_error_desc(rc));
     return NULL;
   }
 
-  return stmt;
+  return batch;
 }
 
-PHP_METHOD(DefaultSession, execute) {
+PHP_METHOD(DefaultSession, executeGrouped) {
   zval* statement = NULL;
+  zval* rows = NULL;
+  zval* partition_key = NULL;
+  zend_long batch_size = 100;
+  zend_long concurrency = 100;
   zval* options = NULL;
   php_driver_session* self = NULL;
   php_driver_statement* stmt = NULL;
-  php_driver_statement simple_statement;
-  HashTable* arguments = NULL;
-  CassConsistency consistency = PHP_DRIVER_DEFAULT_CONSISTENCY;
-  int page_size = -1;
-  char* paging_state_token = NULL;
-  size_t paging_state_token_size = 0;
-  zval* timeout = NULL;
-  long serial_consistency = -1;
-  CassRetryPolicy* retry_policy = NULL;
-  cass_int64_t timestamp = INT64_MIN;
-  php_driver_execution_options* opts = NULL;
+  php_driver_session_options opts;
   php_driver_execution_options local_opts;
-  CassFuture* future = NULL;
-  CassStatement* single = NULL;
-  CassBatch* batch = NULL;
+  php_driver_grouped_column* columns;
+  size_t column_count;
+  php_driver_grouped_batch* group;
+  HashTable groups;
+  php_driver_concurrent_queue* queue;
+  size_t* free_slots;
+  size_t free_count;
+  size_t in_flight = 0;
+  zend_long success = 0;
+  zend_long failure = 0;
+  zend_long batches = 0;
+  zend_bool aborted = 0;
+  zend_bool timed_out = 0;
+  cass_duration_t timeout_us;
+  std::chrono::steady_clock::time_point deadline;
+  php_driver_concurrent_cursor cursor;
+  zval errors;
+  size_t i;
 
-  if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "Ozz|llz", &statement,
+                            php_driver_prepared_statement_ce, &rows, &partition_key, &batch_size,
+                            &concurrency, &options) == FAILURE) {
     return;
   }
 
   self = PHP_DRIVER_GET_SESSION(getThis());
+  stmt = PHP_DRIVER_GET_STATEMENT(statement);
 
-  if (Z_TYPE_P(statement) == IS_STRING) {
-    simple_statement.type = PHP_DRIVER_SIMPLE_STATEMENT;
-    simple_statement.data.simple.cql = Z_STRVAL_P(statement);
-    stmt = &simple_statement;
-  } else if (Z_TYPE_P(statement) == IS_OBJECT &&
-             instanceof_function(Z_OBJCE_P(statement), php_driver_statement_ce)) {
-    stmt = PHP_DRIVER_GET_STATEMENT(statement);
-  } else {
-    INVALID_ARGUMENT(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Statement");
+  if (Z_TYPE_P(rows) != IS_ARRAY &&
+      (Z_TYPE_P(rows) != IS_OBJECT || !instanceof_function(Z_OBJCE_P(rows), zend_ce_traversable))) {
+    INVALID_ARGUMENT(rows, "an array or an instance of Traversable");
   }
 
-  consistency = static_cast<CassConsistency>(self->default_consistency);
-  page_size = self->default_page_size;
-  timeout = &self->default_timeout;
+  if (batch_size <= 0) {
+    zval value;
+    ZVAL_LONG(&value, batch_size);
+    throw_invalid_argument(&value, "batchSize", "a positive integer");
+    return;
+  }
 
-  if (options) {
-    if (Z_TYPE_P(options) != IS_ARRAY &&
-        (Z_TYPE_P(options) != IS_OBJECT ||
-         !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
-      INVALID_ARGUMENT(
-          options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null");
-    }
+  if (concurrency <= 0) {
+    zval value;
+    ZVAL_LONG(&value, concurrency);
+    throw_invalid_argument(&value, "concurrency", "a positive integer");
+    return;
+  }
 
-    if (Z_TYPE_P(options) == IS_OBJECT) {
-      opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
-    } else {
-      if (php_driver_execution_options_build_local_from_array(&local_opts, options) == FAILURE) {
-        return;
-      }
-      opts = &local_opts;
-    }
+  if (resolve_options(self, options, &local_opts, &opts) == FAILURE ||
+      php_driver_future_parse_timeout(opts.timeout, &timeout_us) == FAILURE)
+    return;
+
+  /* The timeout bounds the whole call rather than each batch */
+  deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
 
-    if (!Z_ISUNDEF(opts->arguments)) arguments = Z_ARRVAL(opts->arguments);
+  columns = php_driver_grouped_columns(stmt, partition_key, &column_count);
+  if (!columns) return;
+
+  if (php_driver_concurrent_cursor_init(&cursor, rows) == FAILURE) {
+    php_driver_grouped_columns_free(columns, column_count);
+    return;
+  }
 
-    if (opts->consistency >= 0) consistency = (CassConsistency)opts->consistency;
+  concurrency = (zend_long)php_driver_concurrent_limit(rows, concurrency);
+  queue = php_driver_concurrent_queue_new((size_t)concurrency);
+  free_slots = (size_t*)ecalloc(concurrency, sizeof(size_t));
+  for (i = 0; i < (size_t)concurrency; i++) {
+    free_slots[i] = (size_t)concurrency - i - 1;
+  }
+  free_count = (size_t)concurrency;
 
-    if (opts->page_size >= 0) page_size = opts->page_size;
+  zend_hash_init(&groups, 8, NULL, NULL, 0);
+  array_init(&errors);
 
-    if (opts->paging_state_token) {
-      paging_state_token = opts->paging_state_token;
-      paging_state_token_size = opts->paging_state_token_size;
+  /* Slots hold the keys of the rows sent in each batch. Once the timeout
+   * expires the batches in flight are abandoned and nothing more is sent.
+   */
+  auto complete = [&]() {
+    php_driver_concurrent_slot* slot = php_driver_concurrent_wait(queue, timeout_us, deadline);
+    zend_long count;
+
+    if (!slot) {
+      php_driver_concurrent_abandon(queue, (size_t)concurrency, aborted, timeout_us);
+      timed_out = 1;
+      aborted = 1;
+      in_flight = 0;
+      return;
     }
 
-    if (!Z_ISUNDEF(opts->timeout)) timeout = &opts->timeout;
+    count = zend_hash_num_elements(Z_ARRVAL(slot->key));
 
-    if (opts->serial_consistency >= 0) serial_consistency = opts->serial_consistency;
+    if (cass_future_error_code(slot->future) == CASS_OK) {
+      success += count;
+    } else {
+      failure += count;
+      if (!aborted && php_driver_future_is_error(slot->future) == FAILURE)
+        php_driver_concurrent_capture_all(&errors, &slot->key);
+    }
 
-    if (!Z_ISUNDEF(opts->retry_policy))
-      retry_policy = (ZendCPP::ObjectFetch<php_driver_retry_policy>(&opts->retry_policy))->policy;
+    cass_future_free(slot->future);
+    slot->future = NULL;
+    zval_ptr_dtor(&slot->key);
+    free_slots[free_count++] = slot->index;
+    in_flight--;
+  };
 
-    timestamp = opts->timestamp;
-  }
+  auto send = [&](php_driver_grouped_batch* batch) {
+    php_driver_concurrent_slot* slot;
 
-  switch (stmt->type) {
-    case PHP_DRIVER_SIMPLE_STATEMENT:
-    case PHP_DRIVER_PREPARED_STATEMENT:
-      single = create_single(stmt, arguments, consistency, serial_consistency, page_size,
-                             paging_state_token, paging_state_token_size, retry_policy, timestamp);
+    if (in_flight == (size_t)concurrency) complete();
 
-      if (!single) return;
+    if (timed_out) {
+      cass_batch_free(batch->batch);
+      zval_ptr_dtor(&batch->keys);
+      zval_ptr_dtor(&batch->values);
+      efree(batch);
+      return;
+    }
 
-      future = cass_session_execute((CassSession*)self->session->data, single);
+    slot = &queue->slots[free_slots[--free_count]];
+    ZVAL_COPY_VALUE(&slot->key, &batch->keys);
+    php_driver_concurrent_start(
+        slot, cass_session_execute_batch((CassSession*)self->session->data, batch->batch),
+        self->requests);
+    cass_batch_free(batch->batch);
+    zval_ptr_dtor(&batch->values);
+    efree(batch);
+    in_flight++;
+    batches++;
+  };
+
+  while (!aborted) {
+    CassStatement* single = NULL;
+    php_driver_grouped_batch* head;
+    zval values;
+    zend_ulong hash;
+    zval* row;
+    zval key;
+
+    row = php_driver_concurrent_cursor_next(&cursor, &key);
+    if (!row) {
+      aborted = EG(exception) != NULL;
       break;
-    case PHP_DRIVER_BATCH_STATEMENT:
-      batch = create_batch(stmt, consistency, retry_policy, timestamp);
-
-      if (!batch) return;
+    }
 
-      future = cass_session_execute_batch((CassSession*)self->session->data, batch);
+    if (Z_TYPE_P(row) != IS_ARRAY) {
+      zval_ptr_dtor(&key);
+      throw_invalid_argument(row, "rows", "an array of arguments for each row");
+      aborted = 1;
       break;
-    default:
-      INVALID_ARGUMENT(statement,
-                       "an instance of " PHP_DRIVER_NAMESPACE
-                       "\\SimpleStatement, " PHP_DRIVER_NAMESPACE
-                       "\\PreparedStatement or " PHP_DRIVER_NAMESPACE "\\BatchStatement");
-      return;
-  }
+    }
 
-  do {
-    const CassResult* result = NULL;
-    php_driver_rows* rows = NULL;
+    if (php_driver_grouped_values(columns, column_count, Z_ARRVAL_P(row), &values, &hash) == SUCCESS) {
+      single = php_driver_create_statement(stmt, Z_ARRVAL_P(row));
+      if (!single) zval_ptr_dtor(&values);
+    }
 
-    if (php_driver_future_wait_timed(future, timeout) == FAILURE ||
-        php_driver_future_is_error(future) == FAILURE)
-      break;
+    /* Rows that can't be bound are reported like failed requests */
+    if (!single) {
+      failure++;
+      if (EG(exception)) php_driver_concurrent_capture(&errors, &key);
+      zval_ptr_dtor(&key);
+      continue;
+    }
 
-    result = cass_future_get_result(future);
-    cass_future_free(future);
+    head = (php_driver_grouped_batch*)zend_hash_index_find_ptr(&groups, hash);
+    for (group = head; group; group = group->next) {
+      if (php_driver_grouped_values_equal(&group->values, &values)) break;
+    }
 
-    if (!result) {
-      zend_throw_exception_ex(php_driver_runtime_exception_ce, 0,
-                              "Future doesn't contain a result.");
-      break;
+    if (group) {
+      zval_ptr_dtor(&values);
+    } else {
+      CassBatch* batch = php_driver_grouped_batch_new(&opts);
+
+      if (!batch) {
+        cass_statement_free(single);
+        zval_ptr_dtor(&key);
+        zval_ptr_dtor(&values);
+        aborted = 1;
+        break;
+      }
+
+      group = (php_driver_grouped_batch*)emalloc(sizeof(php_driver_grouped_batch));
+      group->batch = batch;
+      array_init(&group->keys);
+      ZVAL_COPY_VALUE(&group->values, &values);
+      group->hash = hash;
+      group->next = head;
+      zend_hash_index_update_ptr(&groups, hash, group);
     }
 
-    object_init_ex(return_value, php_driver_rows_ce);
-    rows = PHP_DRIVER_GET_ROWS(return_value);
+    cass_batch_add_statement(group->batch, single);
+    cass_statement_free(single);
+    add_next_index_zval(&group->keys, &key);
 
-    if (php_driver_get_result(result, &rows->rows) == FAILURE) {
-      cass_result_free(result);
-      break;
+    /* Full batches are sent right away, the rest once every row has been grouped */
+    if ((zend_long)zend_hash_num_elements(Z_ARRVAL(group->keys)) >= batch_size) {
+      php_driver_grouped_unlink(&groups, group);
+      send(group);
     }
+  }
 
-    if (single && cass_result_has_more_pages(result)) {
-      rows->statement = php_driver_new_ref(single, free_statement);
-      rows->result = php_driver_new_ref((void*)result, free_result);
-      rows->session = php_driver_add_ref(self->session);
-      return;
+  ZEND_HASH_FOREACH_PTR(&groups, head) {
+    while (head) {
+      group = head;
+      head = head->next;
+
+      if (aborted) {
+        cass_batch_free(group->batch);
+        zval_ptr_dtor(&group->keys);
+        zval_ptr_dtor(&group->values);
+        efree(group);
+      } else {
+        send(group);
+      }
     }
+  }
+  ZEND_HASH_FOREACH_END();
+  zend_hash_destroy(&groups);
 
-    cass_result_free(result);
-  } while (0);
+  while (in_flight > 0) complete();
+
+  php_driver_concurrent_cursor_destroy(&cursor);
+  php_driver_grouped_columns_free(columns, column_count);
+  efree(free_slots);
+  php_driver_concurrent_queue_release(queue);
 
-  if (batch) cass_batch_free(batch);
+  if (aborted) {
+    zval_ptr_dtor(&errors);
+    return;
+  }
 
-  if (single) cass_statement_free(single);
+  array_init(return_value);
+  add_assoc_long(return_value, "success", success);
+  add_assoc_long(return_value, "failure", failure);
+  add_assoc_long(return_value, "batches", batches);
+  add_assoc_zval(return_value, "errors", &errors);
 }
 
 PHP_METHOD(DefaultSession, executeAsync) {
@@ -644,19 +1255,10 @@ PHP_METHOD(DefaultSession, executeAsync) {
   php_driver_session* self = NULL;
   php_driver_statement* stmt = NULL;
   php_driver_statement simple_statement;
-  HashTable* arguments = NULL;
-  CassConsistency consistency = PHP_DRIVER_DEFAULT_CONSISTENCY;
-  int page_size = -1;
-  char* paging_state_token = NULL;
-  size_t paging_state_token_size = 0;
-  long serial_consistency = -1;
-  CassRetryPolicy* retry_policy = NULL;
-  cass_int64_t timestamp = INT64_MIN;
-  php_driver_execution_options* opts = NULL;
+  php_driver_session_options opts;
   php_driver_execution_options local_opts;
   php_driver_future_rows* future_rows = NULL;
   CassStatement* single = NULL;
-  CassBatch* batch = NULL;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &statement, &options) == FAILURE) {
     return;
@@ -675,91 +1277,214 @@ PHP_METHOD(DefaultSession, executeAsync) {
     INVALID_ARGUMENT(statement, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Statement");
   }
 
-  consistency = static_cast<CassConsistency>(self->default_consistency);
-  page_size = self->default_page_size;
-
-  if (options) {
-    if (Z_TYPE_P(options) != IS_ARRAY &&
-        (Z_TYPE_P(options) != IS_OBJECT ||
-         !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
-      INVALID_ARGUMENT(
-          options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null");
-    }
-
-    if (Z_TYPE_P(options) == IS_OBJECT) {
-      opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
-    } else {
-      if (php_driver_execution_options_build_local_from_array(&local_opts, options) == FAILURE) {
-        return;
-      }
-      opts = &local_opts;
-    }
-
-    if (!Z_ISUNDEF(opts->arguments)) arguments = Z_ARRVAL(opts->arguments);
-
-    if (opts->consistency >= 0) consistency = (CassConsistency)opts->consistency;
-
-    if (opts->page_size >= 0) page_size = opts->page_size;
-
-    if (opts->paging_state_token) {
-      paging_state_token = opts->paging_state_token;
-      paging_state_token_size = opts->paging_state_token_size;
-    }
-
-    if (opts->serial_consistency >= 0) serial_consistency = opts->serial_consistency;
-
-    if (!Z_ISUNDEF(opts->retry_policy))
-      retry_policy = ZendCPP::ObjectFetch<php_driver_retry_policy>((&opts->retry_policy))->policy;
-
-    timestamp = opts->timestamp;
-  }
+  if (resolve_options(self, options, &local_opts, &opts) == FAILURE) return;
 
   object_init_ex(return_value, php_driver_future_rows_ce);
   future_rows = PHP_DRIVER_GET_FUTURE_ROWS(return_value);
+  future_rows->native_options = opts.native_options;
 
   switch (stmt->type) {
     case PHP_DRIVER_SIMPLE_STATEMENT:
     case PHP_DRIVER_PREPARED_STATEMENT:
-      single = create_single(stmt, arguments, consistency, serial_consistency, page_size,
-                             paging_state_token, paging_state_token_size, retry_policy, timestamp);
+      single = create_single(stmt, opts.arguments, opts.consistency, opts.serial_consistency,
+                             opts.page_size, opts.paging_state_token, opts.paging_state_token_size,
+                             opts.retry_policy, opts.timestamp, opts.execution_profile);
 
       if (!single) return;
 
       future_rows->statement = php_driver_new_ref(single, free_statement);
       future_rows->future = cass_session_execute((CassSession*)self->session->data, single);
       future_rows->session = php_driver_add_ref(self->session);
+      future_rows->requests = php_driver_future_counter_add_ref(self->requests);
+      if (stmt->type == PHP_DRIVER_PREPARED_STATEMENT && stmt->data.prepared.columns)
+        future_rows->columns = php_driver_add_ref(stmt->data.prepared.columns);
+      break;
+    case PHP_DRIVER_BOUND_STATEMENT: {
+      php_driver_statement* prepared = PHP_DRIVER_GET_STATEMENT(&stmt->data.bound.prepared);
+
+      if (php_driver_session_check_bound(&opts) == FAILURE) return;
+
+      future_rows->statement = php_driver_bound_statement_acquire(
+          stmt, opts.consistency, opts.serial_consistency, opts.page_size, opts.paging_state_token,
+          opts.paging_state_token_size, opts.retry_policy, opts.timestamp, opts.execution_profile);
+
+      if (!future_rows->statement) return;
+
+      future_rows->future = cass_session_execute((CassSession*)self->session->data,
+                                                 (CassStatement*)future_rows->statement->data);
+      future_rows->session = php_driver_add_ref(self->session);
+      future_rows->requests = php_driver_future_counter_add_ref(self->requests);
+      if (prepared->data.prepared.columns)
+        future_rows->columns = php_driver_add_ref(prepared->data.prepared.columns);
       break;
+    }
     case PHP_DRIVER_BATCH_STATEMENT:
-      batch = create_batch(stmt, consistency, retry_policy, timestamp);
+      /* Holds the batch until the request completes, batch results never have more pages */
+      future_rows->statement = php_driver_batch_statement_acquire(
+          stmt, opts.consistency, opts.retry_policy, opts.timestamp, opts.execution_profile);
 
-      if (!batch) return;
+      if (!future_rows->statement) return;
 
-      future_rows->future = cass_session_execute_batch((CassSession*)self->session->data, batch);
-      cass_batch_free(batch);
+      future_rows->future = cass_session_execute_batch((CassSession*)self->session->data,
+                                                       (CassBatch*)future_rows->statement->data);
       break;
     default:
       INVALID_ARGUMENT(statement,
                        "an instance of " PHP_DRIVER_NAMESPACE
                        "\\SimpleStatement, " PHP_DRIVER_NAMESPACE
-                       "\\PreparedStatement or " PHP_DRIVER_NAMESPACE "\\BatchStatement");
+                       "\\PreparedStatement, " PHP_DRIVER_NAMESPACE
+                       "\\BoundStatement or " PHP_DRIVER_NAMESPACE "\\BatchStatement");
       return;
   }
+
+  future_rows->state = php_driver_future_track(future_rows->future, self->requests);
+}
+
+/* Resolves the timeout of prepare() and prepareAll() from their options */
+static int php_driver_prepare_timeout(zval* options, php_driver_execution_options* local_opts,
+                                      zval** timeout) {
+  php_driver_execution_options* opts;
+
+  *timeout = NULL;
+
+  if (!options || Z_TYPE_P(options) == IS_NULL) return SUCCESS;
+
+  if (Z_TYPE_P(options) != IS_ARRAY &&
+      (Z_TYPE_P(options) != IS_OBJECT ||
+       !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
+    INVALID_ARGUMENT_VALUE(
+        options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null",
+        FAILURE);
+  }
+
+  if (Z_TYPE_P(options) == IS_OBJECT) {
+    opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
+  } else {
+    if (php_driver_execution_options_build_local_from_array(local_opts, options) == FAILURE) {
+      return FAILURE;
+    }
+    opts = local_opts;
+  }
+
+  *timeout = &opts->timeout;
+  return SUCCESS;
 }
 
-static void free_prepared_statement(void* future) { cass_future_free((CassFuture*)future); }
+/* Returns the prepare future of a statement cached for a persistent session,
+ * the future is owned by the cache.
+ */
+static CassFuture* php_driver_session_find_prepared(php_driver_session* self, zend_string* cql,
+                                                    zend_ulong* hash) {
+  if (!self->persist) return NULL;
+
+  *hash = php_driver_prepared_cache_hash(self->prepared_scope, cql);
+  return php_driver_prepared_cache_find(PHP_DRIVER_G(prepared_cache), *hash, self->prepared_scope,
+                                        cql);
+}
+
+static void php_driver_prepared_statement_init(zval* return_value, CassFuture* future) {
+  php_driver_statement* prepared_statement;
+
+  object_init_ex(return_value, php_driver_prepared_statement_ce);
+  prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
+  prepared_statement->data.prepared.prepared = cass_future_get_prepared(future);
+}
+
+/* Prepares the warm-up statements of a persistent session into the prepared
+ * cache, once per process. Failures are counted rather than thrown so that a
+ * bad statement doesn't prevent connecting. Statements still preparing when
+ * the connect timeout expires count as failed, 0 waits for all of them.
+ * Sessions connected without statements only report the state of a previous
+ * warm-up.
+ */
+void php_driver_session_warmup(php_driver_session* self, php_driver_psession* psession,
+                               HashTable* statements, cass_duration_t timeout_us) {
+  php_driver_warmup* warmup = &psession->warmup;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point deadline = start + std::chrono::microseconds(timeout_us);
+  CassFuture** futures;
+  zend_ulong* hashes;
+  zend_string** queries;
+  zval* cql;
+  size_t count = 0;
+  size_t i;
+
+  if (!statements) {
+    self->warmup = *warmup;
+    return;
+  }
+
+  if (!warmup->complete) {
+    size_t size = zend_hash_num_elements(statements) + 1;
+
+    futures = (CassFuture**)ecalloc(size, sizeof(CassFuture*));
+    hashes = (zend_ulong*)ecalloc(size, sizeof(zend_ulong));
+    queries = (zend_string**)ecalloc(size, sizeof(zend_string*));
+
+    ZEND_HASH_FOREACH_VAL(statements, cql) {
+      warmup->statements++;
+
+      if (php_driver_session_find_prepared(self, Z_STR_P(cql), &hashes[count])) {
+        warmup->prepared++;
+        continue;
+      }
+
+      queries[count] = Z_STR_P(cql);
+      futures[count] = cass_session_prepare_n((CassSession*)self->session->data,
+                                              Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+      php_driver_future_count(futures[count++], self->requests);
+    }
+    ZEND_HASH_FOREACH_END();
+
+    for (i = 0; i < count; i++) {
+      if (timeout_us > 0) {
+        cass_duration_t left = (cass_duration_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                                   deadline - std::chrono::steady_clock::now())
+                                   .count();
+        if (left <= 0 || !cass_future_wait_timed(futures[i], left)) {
+          warmup->failed++;
+          cass_future_free(futures[i]);
+          continue;
+        }
+      }
+
+      if (cass_future_error_code(futures[i]) != CASS_OK) {
+        warmup->failed++;
+        cass_future_free(futures[i]);
+        continue;
+      }
+
+      /* Statements the cache discards (e.g. when it is disabled) aren't prepared for later requests */
+      if (php_driver_prepared_cache_add(PHP_DRIVER_G(prepared_cache), hashes[i],
+                                        self->prepared_scope, queries[i], futures[i],
+                                        PHP_DRIVER_G(prepared_cache_size)) == FAILURE) {
+        cass_future_free(futures[i]);
+        continue;
+      }
+
+      warmup->prepared++;
+    }
+
+    efree(futures);
+    efree(hashes);
+    efree(queries);
+
+    warmup->duration =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  warmup->complete = cass_true;
+  self->warmup = *warmup;
+}
 
 PHP_METHOD(DefaultSession, prepare) {
   zval* cql = NULL;
   zval* options = NULL;
-  char* hash_key = NULL;
-  size_t hash_key_len = 0;
+  zend_ulong hash = 0;
   php_driver_session* self = NULL;
-  php_driver_execution_options* opts = NULL;
   php_driver_execution_options local_opts;
   CassFuture* future = NULL;
   zval* timeout = NULL;
-  php_driver_statement* prepared_statement = NULL;
-  php_driver_pprepared_statement* pprepared_statement = NULL;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS(), "z|z", &cql, &options) == FAILURE) {
     return;
@@ -767,95 +1492,40 @@ PHP_METHOD(DefaultSession, prepare) {
 
   self = PHP_DRIVER_GET_SESSION(getThis());
 
-  if (options) {
-    if (Z_TYPE_P(options) != IS_ARRAY &&
-        (Z_TYPE_P(options) != IS_OBJECT ||
-         !instanceof_function(Z_OBJCE_P(options), php_driver_execution_options_ce))) {
-      INVALID_ARGUMENT(
-          options, "an instance of " PHP_DRIVER_NAMESPACE "\\ExecutionOptions or an array or null");
-    }
-
-    if (Z_TYPE_P(options) == IS_OBJECT) {
-      opts = PHP_DRIVER_GET_EXECUTION_OPTIONS(options);
-    } else {
-      if (php_driver_execution_options_build_local_from_array(&local_opts, options) == FAILURE) {
-        return;
-      }
-      opts = &local_opts;
-    }
-    timeout = &opts->timeout;
+  if (php_driver_prepare_timeout(options, &local_opts, &timeout) == FAILURE) {
+    return;
   }
 
-  if (self->persist) {
-    zval* le;
-
-    spprintf(&hash_key, 0, "%s%s", self->hash_key, Z_STRVAL_P(cql));
-    hash_key_len =
-        spprintf(&hash_key, 0, "%s:prepared_statement:%s", hash_key, SAFE_STR(self->keyspace));
-
-    if (PHP5TO7_ZEND_HASH_FIND(&EG(persistent_list), hash_key, hash_key_len + 1, le) &&
-        Z_RES_P(le)->type == php_le_php_driver_prepared_statement()) {
-      pprepared_statement = (php_driver_pprepared_statement*)Z_RES_P(le)->ptr;
-      object_init_ex(return_value, php_driver_prepared_statement_ce);
-      prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
-      prepared_statement->data.prepared.prepared =
-          cass_future_get_prepared(pprepared_statement->future);
-      self->session = php_driver_add_ref(pprepared_statement->ref);
-      future = pprepared_statement->future;
-    }
+  future = php_driver_session_find_prepared(self, Z_STR_P(cql), &hash);
+  if (future) {
+    php_driver_prepared_statement_init(return_value, future);
+    return;
   }
 
-  if (future == NULL) {
-    zval resource;
-
-    future =
-        cass_session_prepare_n((CassSession*)self->session->data, Z_STRVAL_P(cql), Z_STRLEN_P(cql));
-
-    if (php_driver_future_wait_timed(future, timeout) == SUCCESS &&
-        php_driver_future_is_error(future) == SUCCESS) {
-      object_init_ex(return_value, php_driver_prepared_statement_ce);
-      prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
-      prepared_statement->data.prepared.prepared = cass_future_get_prepared(future);
-
-      if (self->persist) {
-        pprepared_statement =
-            (php_driver_pprepared_statement*)pecalloc(1, sizeof(php_driver_pprepared_statement), 1);
-        pprepared_statement->ref = php_driver_new_peref(future, free_prepared_statement, 1);
-        pprepared_statement->ref = php_driver_add_ref(self->session);
-        pprepared_statement->future = future;
-
-#if PHP_MAJOR_VERSION >= 7
-        ZVAL_NEW_PERSISTENT_RES(&resource, 0, pprepared_statement,
-                                php_le_php_driver_prepared_statement());
-        PHP5TO7_ZEND_HASH_UPDATE(&EG(persistent_list), hash_key, hash_key_len + 1, &resource,
-                                 sizeof(zval));
-        PHP_DRIVER_G(persistent_prepared_statements)
-        ++;
-#else
-        resource.type = php_le_php_driver_prepared_statement();
-        resource.ptr = pprepared_statement;
-        PHP5TO7_ZEND_HASH_UPDATE(&EG(persistent_list), hash_key, hash_key_len + 1, resource,
-                                 sizeof(zendObject));
-        PHP_DRIVER_G(persistent_prepared_statements)
-        ++;
-#endif
-      }
-    }
-  }
+  future =
+      cass_session_prepare_n((CassSession*)self->session->data, Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+  php_driver_future_count(future, self->requests);
 
-  if (self->persist) {
-    if (php_driver_future_is_error(future) == FAILURE) {
-      (void)PHP5TO7_ZEND_HASH_DEL(&EG(persistent_list), hash_key, hash_key_len + 1);
+  if (php_driver_future_wait_timed(future, timeout) == SUCCESS &&
+      php_driver_future_is_error(future) == SUCCESS) {
+    php_driver_prepared_statement_init(return_value, future);
+
+    /* The cache keeps the future, each hit takes a new reference to its statement */
+    if (self->persist &&
+        php_driver_prepared_cache_add(PHP_DRIVER_G(prepared_cache), hash, self->prepared_scope,
+                                      Z_STR_P(cql), future,
+                                      PHP_DRIVER_G(prepared_cache_size)) == SUCCESS) {
+      return;
     }
-    efree(hash_key);
-  } else {
-    cass_future_free(future);
   }
+
+  cass_future_free(future);
 }
 
 PHP_METHOD(DefaultSession, prepareAsync) {
   zval* cql = NULL;
   zval* options = NULL;
+  zend_ulong hash = 0;
   php_driver_session* self = NULL;
   CassFuture* future = NULL;
   php_driver_future_prepared_statement* future_prepared = NULL;
@@ -866,13 +1536,151 @@ PHP_METHOD(DefaultSession, prepareAsync) {
 
   self = PHP_DRIVER_GET_SESSION(getThis());
 
-  future =
-      cass_session_prepare_n((CassSession*)self->session->data, Z_STRVAL_P(cql), Z_STRLEN_P(cql));
-
   object_init_ex(return_value, php_driver_future_prepared_statement_ce);
   future_prepared = PHP_DRIVER_GET_FUTURE_PREPARED_STATEMENT(return_value);
 
-  future_prepared->future = future;
+  /* Cached statements are returned by an already resolved future */
+  future = php_driver_session_find_prepared(self, Z_STR_P(cql), &hash);
+  if (future) {
+    php_driver_prepared_statement_init(&future_prepared->prepared_statement, future);
+    return;
+  }
+
+  future_prepared->future =
+      cass_session_prepare_n((CassSession*)self->session->data, Z_STRVAL_P(cql), Z_STRLEN_P(cql));
+  future_prepared->state = php_driver_future_track(future_prepared->future, self->requests);
+
+  if (self->persist) {
+    future_prepared->cql = zend_string_copy(Z_STR_P(cql));
+    future_prepared->hash = hash;
+    future_prepared->scope = self->prepared_scope;
+  }
+}
+
+PHP_METHOD(DefaultSession, prepareAll) {
+  zval* cqls = NULL;
+  zval* options = NULL;
+  zval* cql;
+  zval* timeout = NULL;
+  zend_ulong index;
+  zend_string* key;
+  php_driver_session* self = NULL;
+  php_driver_execution_options local_opts;
+  cass_duration_t timeout_us;
+  std::chrono::steady_clock::time_point deadline;
+  HashTable pending;
+  zend_ulong* hashes;
+  zend_string** queries;
+  CassFuture** futures;
+  size_t count;
+  size_t i = 0;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|z", &cqls, &options) == FAILURE) {
+    return;
+  }
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  if (php_driver_prepare_timeout(options, &local_opts, &timeout) == FAILURE ||
+      php_driver_future_parse_timeout(timeout, &timeout_us) == FAILURE) {
+    return;
+  }
+
+  ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(cqls), cql) {
+    if (Z_TYPE_P(cql) != IS_STRING) {
+      throw_invalid_argument(cql, "cql", "a string");
+      return;
+    }
+  }
+  ZEND_HASH_FOREACH_END();
+
+  count = zend_hash_num_elements(Z_ARRVAL_P(cqls));
+  futures = (CassFuture**)ecalloc(count + 1, sizeof(CassFuture*));
+  queries = (zend_string**)ecalloc(count + 1, sizeof(zend_string*));
+  hashes = (zend_ulong*)ecalloc(count + 1, sizeof(zend_ulong));
+  zend_hash_init(&pending, count, NULL, NULL, 0);
+  array_init_size(return_value, count);
+
+  /* Every statement missing from the cache is prepared at the same time, each
+   * distinct query only once
+   */
+  ZEND_HASH_FOREACH_KEY_VAL(Z_ARRVAL_P(cqls), index, key, cql) {
+    zval prepared;
+    CassFuture* future = php_driver_session_find_prepared(self, Z_STR_P(cql), &hashes[i]);
+
+    if (future) {
+      php_driver_prepared_statement_init(&prepared, future);
+    } else {
+      zval* started = zend_hash_find(&pending, Z_STR_P(cql));
+
+      if (!started) {
+        zval position;
+        futures[i] = cass_session_prepare_n((CassSession*)self->session->data, Z_STRVAL_P(cql),
+                                            Z_STRLEN_P(cql));
+        php_driver_future_count(futures[i], self->requests);
+        queries[i] = Z_STR_P(cql);
+        ZVAL_LONG(&position, i);
+        started = zend_hash_add_new(&pending, Z_STR_P(cql), &position);
+      }
+      ZVAL_COPY_VALUE(&prepared, started);
+    }
+
+    if (key)
+      zend_hash_add_new(Z_ARRVAL_P(return_value), key, &prepared);
+    else
+      zend_hash_index_add_new(Z_ARRVAL_P(return_value), index, &prepared);
+    i++;
+  }
+  ZEND_HASH_FOREACH_END();
+
+  deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+
+  for (i = 0; i < count; i++) {
+    if (!futures[i]) continue;
+
+    if (timeout_us > 0) {
+      cass_duration_t left = (cass_duration_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                                 deadline - std::chrono::steady_clock::now())
+                                 .count();
+      if (left <= 0 || !cass_future_wait_timed(futures[i], left)) {
+        zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
+                                "Prepared statements haven't resolved within %f seconds",
+                                timeout_us / 1000000.0);
+        break;
+      }
+    }
+
+    if (php_driver_future_is_error(futures[i]) == FAILURE) break;
+  }
+
+  if (EG(exception)) {
+    zval_ptr_dtor(return_value);
+    ZVAL_NULL(return_value);
+  } else {
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(return_value), cql) {
+      if (Z_TYPE_P(cql) == IS_LONG) {
+        php_driver_prepared_statement_init(cql, futures[Z_LVAL_P(cql)]);
+      }
+    }
+    ZEND_HASH_FOREACH_END();
+  }
+
+  for (i = 0; i < count; i++) {
+    if (!futures[i]) continue;
+
+    if (!EG(exception) && self->persist &&
+        php_driver_prepared_cache_add(PHP_DRIVER_G(prepared_cache), hashes[i],
+                                      self->prepared_scope, queries[i], futures[i],
+                                      PHP_DRIVER_G(prepared_cache_size)) == SUCCESS) {
+      continue;
+    }
+    cass_future_free(futures[i]);
+  }
+
+  efree(futures);
+  efree(queries);
+  efree(hashes);
+  zend_hash_destroy(&pending);
 }
 
 PHP_METHOD(DefaultSession, close) {
@@ -918,14 +1726,20 @@ PHP_METHOD(DefaultSession, closeAsync) {
 
 PHP_METHOD(DefaultSession, metrics) {
   CassMetrics metrics;
+  CassSpeculativeExecutionMetrics speculative;
+  zend_bool flat = 0;
   zval requests;
   zval stats;
   zval errors;
+  zval speculative_executions;
+  zval prepared_cache;
+  php_driver_prepared_cache* cache = PHP_DRIVER_G(prepared_cache);
   php_driver_session* self = PHP_DRIVER_GET_SESSION(getThis());
 
-  if (zend_parse_parameters_none() == FAILURE) return;
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "|b", &flat) == FAILURE) return;
 
   cass_session_get_metrics((CassSession*)self->session->data, &metrics);
+  cass_session_get_speculative_execution_metrics((CassSession*)self->session->data, &speculative);
 
   array_init(&requests);
   add_assoc_long(&requests, "min", metrics.requests.min);
@@ -942,6 +1756,7 @@ PHP_METHOD(DefaultSession, metrics) {
   add_assoc_double(&requests, "m1_rate", metrics.requests.one_minute_rate);
   add_assoc_double(&requests, "m5_rate", metrics.requests.five_minute_rate);
   add_assoc_double(&requests, "m15_rate", metrics.requests.fifteen_minute_rate);
+  add_assoc_long(&requests, "in_flight", php_driver_future_counter_in_flight(self->requests));
 
   array_init(&stats);
   add_assoc_long(&stats, "total_connections", metrics.stats.total_connections);
@@ -956,10 +1771,73 @@ PHP_METHOD(DefaultSession, metrics) {
   add_assoc_long(&errors, "pending_request_timeouts", metrics.errors.pending_request_timeouts);
   add_assoc_long(&errors, "request_timeouts", metrics.errors.request_timeouts);
 
+  array_init(&speculative_executions);
+  add_assoc_long(&speculative_executions, "min", speculative.min);
+  add_assoc_long(&speculative_executions, "max", speculative.max);
+  add_assoc_long(&speculative_executions, "mean", speculative.mean);
+  add_assoc_long(&speculative_executions, "stddev", speculative.stddev);
+  add_assoc_long(&speculative_executions, "median", speculative.median);
+  add_assoc_long(&speculative_executions, "p75", speculative.percentile_75th);
+  add_assoc_long(&speculative_executions, "p95", speculative.percentile_95th);
+  add_assoc_long(&speculative_executions, "p98", speculative.percentile_98th);
+  add_assoc_long(&speculative_executions, "p99", speculative.percentile_99th);
+  add_assoc_long(&speculative_executions, "p999", speculative.percentile_999th);
+  add_assoc_long(&speculative_executions, "count", speculative.count);
+  add_assoc_double(&speculative_executions, "percentage", speculative.percentage);
+
+  array_init(&prepared_cache);
+  add_assoc_long(&prepared_cache, "size", zend_hash_num_elements(&cache->entries));
+  add_assoc_long(&prepared_cache, "capacity", PHP_DRIVER_G(prepared_cache_size));
+  add_assoc_long(&prepared_cache, "hits", cache->hits);
+  add_assoc_long(&prepared_cache, "misses", cache->misses);
+  add_assoc_long(&prepared_cache, "evictions", cache->evictions);
+
   array_init(return_value);
   add_assoc_zval(return_value, "stats", &stats);
   add_assoc_zval(return_value, "requests", &requests);
   add_assoc_zval(return_value, "errors", &errors);
+  add_assoc_zval(return_value, "speculative_executions", &speculative_executions);
+  add_assoc_zval(return_value, "prepared_cache", &prepared_cache);
+
+  /* Joins the section and the metric names, e.g. "requests_p99" */
+  if (flat) {
+    zval sections;
+    zend_string* section;
+    zend_string* name;
+    zval* values;
+    zval* value;
+
+    ZVAL_COPY_VALUE(&sections, return_value);
+    array_init(return_value);
+
+    ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL(sections), section, values) {
+      ZEND_HASH_FOREACH_STR_KEY_VAL(Z_ARRVAL_P(values), name, value) {
+        zend_string* key = zend_strpprintf(0, "%s_%s", ZSTR_VAL(section), ZSTR_VAL(name));
+        Z_TRY_ADDREF_P(value);
+        zend_hash_add_new(Z_ARRVAL_P(return_value), key, value);
+        zend_string_release(key);
+      }
+      ZEND_HASH_FOREACH_END();
+    }
+    ZEND_HASH_FOREACH_END();
+
+    zval_ptr_dtor(&sections);
+  }
+}
+
+PHP_METHOD(DefaultSession, warmupStatus) {
+  php_driver_session* self;
+
+  if (zend_parse_parameters_none() == FAILURE) return;
+
+  self = PHP_DRIVER_GET_SESSION(getThis());
+
+  array_init(return_value);
+  add_assoc_bool(return_value, "complete", self->warmup.complete);
+  add_assoc_long(return_value, "statements", self->warmup.statements);
+  add_assoc_long(return_value, "prepared", self->warmup.prepared);
+  add_assoc_long(return_value, "failed", self->warmup.failed);
+  add_assoc_double(return_value, "duration", self->warmup.duration);
 }
 
 PHP_METHOD(DefaultSession, schema) {
@@ -982,27 +1860,58 @@ ZEND_ARG_INFO(0, statement)
 ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execute_concurrent, 0, ZEND_RETURN_VALUE, 2)
+ZEND_ARG_INFO(0, statement)
+ZEND_ARG_INFO(0, arguments)
+ZEND_ARG_INFO(0, concurrency)
+ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execute_grouped, 0, ZEND_RETURN_VALUE, 3)
+PHP_DRIVER_NAMESPACE_ZEND_ARG_OBJ_INFO(0, statement, PreparedStatement, 0)
+ZEND_ARG_INFO(0, rows)
+ZEND_ARG_INFO(0, partitionKey)
+ZEND_ARG_INFO(0, batchSize)
+ZEND_ARG_INFO(0, concurrency)
+ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare, 0, ZEND_RETURN_VALUE, 1)
 ZEND_ARG_INFO(0, cql)
 ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare_all, 0, ZEND_RETURN_VALUE, 1)
+ZEND_ARG_INFO(0, cqls)
+ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
 ZEND_ARG_INFO(0, timeout)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_metrics, 0, ZEND_RETURN_VALUE, 0)
+ZEND_ARG_INFO(0, flat)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
 static zend_function_entry php_driver_default_session_methods[] = {
     PHP_ME(DefaultSession, execute, arginfo_execute, ZEND_ACC_PUBLIC)
         PHP_ME(DefaultSession, executeAsync, arginfo_execute, ZEND_ACC_PUBLIC)
+            PHP_ME(DefaultSession, executeStream, arginfo_execute, ZEND_ACC_PUBLIC)
+            PHP_ME(DefaultSession, executeConcurrent, arginfo_execute_concurrent, ZEND_ACC_PUBLIC)
+            PHP_ME(DefaultSession, executeGrouped, arginfo_execute_grouped, ZEND_ACC_PUBLIC)
             PHP_ME(DefaultSession, prepare, arginfo_prepare, ZEND_ACC_PUBLIC)
                 PHP_ME(DefaultSession, prepareAsync, arginfo_prepare, ZEND_ACC_PUBLIC)
+                    PHP_ME(DefaultSession, prepareAll, arginfo_prepare_all, ZEND_ACC_PUBLIC)
                     PHP_ME(DefaultSession, close, arginfo_timeout, ZEND_ACC_PUBLIC)
                         PHP_ME(DefaultSession, closeAsync, arginfo_none, ZEND_ACC_PUBLIC)
-                            PHP_ME(DefaultSession, metrics, arginfo_none, ZEND_ACC_PUBLIC) PHP_ME(
-                                DefaultSession, schema, arginfo_none, ZEND_ACC_PUBLIC) PHP_FE_END};
+                            PHP_ME(DefaultSession, metrics, arginfo_metrics, ZEND_ACC_PUBLIC)
+                                PHP_ME(DefaultSession, warmupStatus, arginfo_none, ZEND_ACC_PUBLIC)
+                                    PHP_ME(DefaultSession, schema, arginfo_none, ZEND_ACC_PUBLIC)
+                                        PHP_FE_END};
 
 static zend_object_handlers php_driver_default_session_handlers;
 
@@ -1031,6 +1940,7 @@ static void php_driver_default_session_free(zend_object* object) {
   php_driver_session* self = PHP5TO7_ZEND_OBJECT_GET(session, object);
 
   php_driver_del_peref(&self->session, 1);
+  php_driver_future_counter_release(&self->requests);
   PHP5TO7_ZVAL_MAYBE_DESTROY(self->default_timeout);
 
   zend_object_std_dtor(&self->zendObject);
@@ -1040,11 +1950,13 @@ static zend_object* php_driver_default_session_new(zend_class_entry* ce) {
   php_driver_session* self = PHP5TO7_ZEND_OBJECT_ECALLOC(session, ce);
 
   self->session = NULL;
+  self->requests = php_driver_future_counter_new();
   self->persist = cass_false;
   self->default_consistency = PHP_DRIVER_DEFAULT_CONSISTENCY;
   self->default_page_size = 5000;
   self->keyspace = NULL;
   self->hash_key = NULL;
+  self->prepared_scope = 0;
   ZVAL_UNDEF(&self->default_timeout);
 
   PHP5TO7_ZEND_OBJECT_INIT_EX(session, default_session, self, ce);
@@ -18,6 +18,7 @@
 #include "php_driver_types.h"
 #include "util/consistency.h"
 #include "util/math.h"
+#include "util/result.h"
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_execution_options_ce = NULL;
 
@@ -29,6 +30,8 @@ static void init_execution_options(php_driver_execution_options *self)
     self->paging_state_token = NULL;
     self->paging_state_token_size = 0;
     self->timestamp = INT64_MIN;
+    self->native_options = 0;
+    self->execution_profile = NULL;
     ZVAL_UNDEF(&self->arguments);
     ZVAL_UNDEF(&self->timeout);
     ZVAL_UNDEF(&self->retry_policy);
@@ -44,6 +47,9 @@ static zend_result build_from_array(php_driver_execution_options *self, zval *op
     zval *arguments = NULL;
     zval *retry_policy = NULL;
     zval *timestamp = NULL;
+    zval *native_scalars = NULL;
+    zval *native_integers = NULL;
+    zval *execution_profile = NULL;
 
     if (PHP5TO7_ZEND_HASH_FIND(Z_ARRVAL_P(options), "consistency", sizeof("consistency"), consistency))
     {
@@ -187,9 +193,68 @@ static zend_result build_from_array(php_driver_execution_options *self, zval *op
             return FAILURE;
         }
     }
+
+    if (PHP5TO7_ZEND_HASH_FIND(Z_ARRVAL_P(options), "native_scalars", sizeof("native_scalars"), native_scalars))
+    {
+        if (Z_TYPE_P(native_scalars) != IS_TRUE && Z_TYPE_P(native_scalars) != IS_FALSE)
+        {
+            throw_invalid_argument(native_scalars, "native_scalars", "a boolean");
+            return FAILURE;
+        }
+
+        if (Z_TYPE_P(native_scalars) == IS_TRUE)
+        {
+            self->native_options |= PHP_DRIVER_NATIVE_SCALARS;
+        }
+        else
+        {
+            self->native_options &= ~PHP_DRIVER_NATIVE_SCALARS;
+        }
+    }
+
+    if (PHP5TO7_ZEND_HASH_FIND(Z_ARRVAL_P(options), "native_integers", sizeof("native_integers"), native_integers))
+    {
+        if (Z_TYPE_P(native_integers) != IS_TRUE && Z_TYPE_P(native_integers) != IS_FALSE)
+        {
+            throw_invalid_argument(native_integers, "native_integers", "a boolean");
+            return FAILURE;
+        }
+
+        if (Z_TYPE_P(native_integers) == IS_TRUE)
+        {
+            self->native_options |= PHP_DRIVER_NATIVE_INTEGERS;
+        }
+        else
+        {
+            self->native_options &= ~PHP_DRIVER_NATIVE_INTEGERS;
+        }
+    }
+
+    if (PHP5TO7_ZEND_HASH_FIND(Z_ARRVAL_P(options), "execution_profile", sizeof("execution_profile"),
+                               execution_profile))
+    {
+        if (Z_TYPE_P(execution_profile) != IS_STRING)
+        {
+            throw_invalid_argument(execution_profile, "execution_profile", "a string");
+            return FAILURE;
+        }
+        if (copy)
+        {
+            self->execution_profile = zend_string_copy(Z_STR_P(execution_profile));
+        }
+        else
+        {
+            self->execution_profile = Z_STR_P(execution_profile);
+        }
+    }
     return SUCCESS;
 }
 
+int php_driver_execution_options_build_from_array(php_driver_execution_options *self, zval *options)
+{
+    return build_from_array(self, options, 1);
+}
+
 int php_driver_execution_options_build_local_from_array(php_driver_execution_options *self, zval *options)
 {
     init_execution_options(self);
@@ -289,6 +354,14 @@ PHP_METHOD(ExecutionOptions, __get)
         }
         RETURN_ZVAL(&self->retry_policy, 1, 0);
     }
+    else if (name_len == 16 && strncmp("executionProfile", name, name_len) == 0)
+    {
+        if (!self->execution_profile)
+        {
+            RETURN_NULL();
+        }
+        RETURN_STR_COPY(self->execution_profile);
+    }
     else if (name_len == 9 && strncmp("timestamp", name, name_len) == 0)
     {
         char *string;
@@ -304,6 +377,14 @@ PHP_METHOD(ExecutionOptions, __get)
         RETVAL_STRING(string);
         efree(string);
     }
+    else if (name_len == 13 && strncmp("nativeScalars", name, name_len) == 0)
+    {
+        RETURN_BOOL((self->native_options & PHP_DRIVER_NATIVE_SCALARS) != 0);
+    }
+    else if (name_len == 14 && strncmp("nativeIntegers", name, name_len) == 0)
+    {
+        RETURN_BOOL((self->native_options & PHP_DRIVER_NATIVE_INTEGERS) != 0);
+    }
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 0)
@@ -352,6 +433,10 @@ static void php_driver_execution_options_free(zend_object *object)
     {
         efree(self->paging_state_token);
     }
+    if (self->execution_profile)
+    {
+        zend_string_release(self->execution_profile);
+    }
     PHP5TO7_ZVAL_MAYBE_DESTROY(self->arguments);
     PHP5TO7_ZVAL_MAYBE_DESTROY(self->timeout);
     PHP5TO7_ZVAL_MAYBE_DESTROY(self->retry_policy);
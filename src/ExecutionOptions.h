@@ -5,4 +5,5 @@
 
 BEGIN_EXTERN_C()
 int php_driver_execution_options_build_local_from_array(php_driver_execution_options *self, zval *options);
+int php_driver_execution_options_build_from_array(php_driver_execution_options *self, zval *options);
 END_EXTERN_C()
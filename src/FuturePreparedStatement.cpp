@@ -15,8 +15,10 @@
  */
 
 #include "php_driver.h"
+#include "php_driver_globals.h"
 #include "php_driver_types.h"
 #include "util/future.h"
+#include "util/prepared_cache.h"
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_future_prepared_statement_ce = NULL;
 
@@ -43,12 +45,20 @@ PHP_METHOD(FuturePreparedStatement, get)
     return;
   }
 
-  object_init_ex(return_value, php_driver_statement_ce);
+  object_init_ex(return_value, php_driver_prepared_statement_ce);
   ZVAL_COPY(&self->prepared_statement, return_value);
 
   prepared_statement = PHP_DRIVER_GET_STATEMENT(return_value);
 
   prepared_statement->data.prepared.prepared = cass_future_get_prepared(self->future);
+
+  /* Statements of persistent sessions are handed over to the prepared cache */
+  if (self->cql &&
+      php_driver_prepared_cache_add(PHP_DRIVER_G(prepared_cache), self->hash, self->scope,
+                                    self->cql, self->future,
+                                    PHP_DRIVER_G(prepared_cache_size)) == SUCCESS) {
+    self->future = NULL;
+  }
 }
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
@@ -99,6 +109,11 @@ php_driver_future_prepared_statement_free(zend_object *object )
     self->future = NULL;
   }
 
+  php_driver_future_state_release(&self->state);
+
+  if (self->cql)
+    zend_string_release(self->cql);
+
   PHP5TO7_ZVAL_MAYBE_DESTROY(self->prepared_statement);
 
   zend_object_std_dtor(&self->zendObject);
@@ -112,6 +127,8 @@ php_driver_future_prepared_statement_new(zend_class_entry *ce )
       PHP5TO7_ZEND_OBJECT_ECALLOC(future_prepared_statement, ce);
 
   self->future = NULL;
+  self->state = NULL;
+  self->cql = NULL;
   ZVAL_UNDEF(&self->prepared_statement);
 
   PHP5TO7_ZEND_OBJECT_INIT(future_prepared_statement, self, ce);
@@ -16,6 +16,7 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "src/Database/Rows.h"
 #include "util/future.h"
 #include "util/ref.h"
 #include "util/result.h"
@@ -70,22 +71,18 @@ PHP_METHOD(FutureRows, get)
     return;
   }
 
-  if (Z_ISUNDEF(self->rows)) {
-    if (php_driver_get_result((const CassResult *) self->result->data,
-                                 &self->rows ) == FAILURE) {
-      PHP5TO7_ZVAL_MAYBE_DESTROY(self->rows);
-      return;
-    }
-  }
-
   object_init_ex(return_value, php_driver_rows_ce);
   rows = PHP_DRIVER_GET_ROWS(return_value);
 
-  ZVAL_COPY(&rows->rows,
-                    &self->rows);
+  php_driver_rows_init(rows, self->result, self->columns, self->native_options);
+  if (self->columns != rows->columns) {
+    php_driver_del_ref(&self->columns);
+    self->columns = php_driver_add_ref(rows->columns);
+  }
 
   if (cass_result_has_more_pages((const CassResult *)self->result->data)) {
     rows->session   = php_driver_add_ref(self->session);
+    rows->requests  = php_driver_future_counter_add_ref(self->requests);
     rows->statement = php_driver_add_ref(self->statement);
     rows->result    = php_driver_add_ref(self->result);
   }
@@ -133,11 +130,23 @@ php_driver_future_rows_free(zend_object *object )
 {
   php_driver_future_rows *self = PHP5TO7_ZEND_OBJECT_GET(future_rows, object);
 
-  PHP5TO7_ZVAL_MAYBE_DESTROY(self->rows);
+  /* A discarded request keeps the statement of a BoundStatement or a
+   * BatchStatement until it completes, so that it isn't modified in place
+   * meanwhile. Statements nothing else references are freed right away.
+   */
+  if (self->future && self->statement && self->statement->count > 1 &&
+      !cass_future_ready(self->future)) {
+    php_driver_future_release_later(self->future, self->statement);
+    self->future    = NULL;
+    self->statement = NULL;
+  }
 
   php_driver_del_ref(&self->statement);
   php_driver_del_peref(&self->session, 1);
+  php_driver_future_counter_release(&self->requests);
   php_driver_del_ref(&self->result);
+  php_driver_del_ref(&self->columns);
+  php_driver_future_state_release(&self->state);
 
   if (self->future) {
     cass_future_free(self->future);
@@ -154,10 +163,13 @@ php_driver_future_rows_new(zend_class_entry *ce )
       PHP5TO7_ZEND_OBJECT_ECALLOC(future_rows, ce);
 
   self->future    = NULL;
+  self->state     = NULL;
   self->statement = NULL;
   self->result    = NULL;
   self->session   = NULL;
-  ZVAL_UNDEF(&self->rows);
+  self->requests  = NULL;
+  self->columns   = NULL;
+  self->native_options = 0;
 
   PHP5TO7_ZEND_OBJECT_INIT(future_rows, self, ce);
 }
@@ -17,7 +17,9 @@
 #include "php_driver.h"
 #include "php_driver_globals.h"
 #include "php_driver_types.h"
+#include "src/DefaultSession.h"
 #include "util/future.h"
+#include "util/prepared_cache.h"
 #include "util/ref.h"
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_future_session_ce = NULL;
@@ -28,11 +30,17 @@ PHP_METHOD(FutureSession, get)
   CassError rc = CASS_OK;
   php_driver_session *session = NULL;
   php_driver_future_session *self = NULL;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  cass_duration_t timeout_us;
 
   if (zend_parse_parameters(ZEND_NUM_ARGS() , "|z", &timeout) == FAILURE) {
     return;
   }
 
+  if (php_driver_future_parse_timeout(timeout, &timeout_us) == FAILURE) {
+    return;
+  }
+
   self = PHP_DRIVER_GET_FUTURE_SESSION(getThis());
 
   if (self->exception_message) {
@@ -51,6 +59,10 @@ PHP_METHOD(FutureSession, get)
   session->session = php_driver_add_ref(self->session);
   session->persist = self->persist;
 
+  if (self->persist) {
+    session->prepared_scope = php_driver_prepared_cache_scope(self->hash_key, self->hash_key_len);
+  }
+
   if (php_driver_future_wait_timed(self->future, timeout ) == FAILURE) {
     return;
   }
@@ -80,6 +92,17 @@ PHP_METHOD(FutureSession, get)
     return;
   }
 
+  if (self->persist) {
+    zval *le;
+
+    if (PHP5TO7_ZEND_HASH_FIND(&EG(persistent_list), self->hash_key, self->hash_key_len + 1, le) &&
+        Z_RES_P(le)->type == php_le_php_driver_session()) {
+      php_driver_session_warmup(session, (php_driver_psession *) Z_RES_P(le)->ptr,
+                                self->warmup_statements,
+                                php_driver_future_time_left(timeout_us, start));
+    }
+  }
+
   ZVAL_COPY(&self->default_session, return_value);
 }
 
@@ -140,6 +163,10 @@ php_driver_future_session_free(zend_object *object )
     efree(self->exception_message);
   }
 
+  if (self->warmup_statements) {
+    zend_array_release(self->warmup_statements);
+  }
+
   PHP5TO7_ZVAL_MAYBE_DESTROY(self->default_session);
 
   zend_object_std_dtor(&self->zendObject);
@@ -157,6 +184,7 @@ php_driver_future_session_new(zend_class_entry *ce )
   self->exception_message = nullptr;
   self->hash_key          = nullptr;
   self->persist           = cass_false;
+  self->warmup_statements = nullptr;
 
   ZVAL_UNDEF(&self->default_session);
 
@@ -0,0 +1,300 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "php_driver.h"
+#include "php_driver_types.h"
+#include "util/future.h"
+BEGIN_EXTERN_C()
+zend_class_entry *php_driver_futures_ce = NULL;
+
+typedef enum {
+  PHP_DRIVER_FUTURES_ALL,
+  PHP_DRIVER_FUTURES_ANY,
+  PHP_DRIVER_FUTURES_SETTLED
+} php_driver_futures_mode;
+
+typedef struct {
+  zend_ulong index;
+  zend_string *key;
+  zval *future;
+  CassFuture *native;
+  php_driver_future_state *state;
+  zend_bool done;
+} php_driver_futures_entry;
+
+/* Returns the driver future backing a pending future object, or NULL when the
+ * future can be resolved right away. Sets the state its completion is watched
+ * through, futures that weren't tracked when sent are tracked from now on.
+ */
+static CassFuture *
+php_driver_futures_native(zval *future, php_driver_future_state **state)
+{
+  CassFuture *native = NULL;
+  php_driver_future_state **owned = NULL;
+
+  if (Z_OBJCE_P(future) == php_driver_future_rows_ce) {
+    php_driver_future_rows *future_rows = PHP_DRIVER_GET_FUTURE_ROWS(future);
+    native = future_rows->result ? NULL : future_rows->future;
+    owned  = &future_rows->state;
+  } else if (Z_OBJCE_P(future) == php_driver_future_prepared_statement_ce) {
+    php_driver_future_prepared_statement *future_prepared =
+        PHP_DRIVER_GET_FUTURE_PREPARED_STATEMENT(future);
+    native = Z_ISUNDEF(future_prepared->prepared_statement) ? future_prepared->future : NULL;
+    owned  = &future_prepared->state;
+  }
+
+  if (native && !*owned)
+    *owned = php_driver_future_track(native, NULL);
+
+  *state = native ? *owned : NULL;
+  return native;
+}
+
+static void
+php_driver_futures_wait(HashTable *futures, zval *timeout,
+                        php_driver_futures_mode mode, zval *return_value)
+{
+  php_driver_futures_entry *entries;
+  size_t count = zend_hash_num_elements(futures);
+  size_t remaining = count;
+  size_t i = 0;
+  zend_ulong index;
+  zend_string *key;
+  zval *future;
+  zval last_error;
+  cass_duration_t timeout_us;
+  std::chrono::steady_clock::time_point deadline;
+  php_driver_future_queue queue;
+
+  if (php_driver_future_parse_timeout(timeout, &timeout_us) == FAILURE)
+    return;
+
+  if (count == 0) {
+    if (mode == PHP_DRIVER_FUTURES_ANY) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "At least one future is required");
+      return;
+    }
+    array_init(return_value);
+    return;
+  }
+
+  ZEND_HASH_FOREACH_VAL(futures, future) {
+    if (Z_TYPE_P(future) != IS_OBJECT ||
+        !instanceof_function(Z_OBJCE_P(future), php_driver_future_ce)) {
+      throw_invalid_argument(future, "future", "an instance of " PHP_DRIVER_NAMESPACE "\\Future");
+      return;
+    }
+  } ZEND_HASH_FOREACH_END();
+
+  entries = (php_driver_futures_entry *) ecalloc(count, sizeof(php_driver_futures_entry));
+
+  if (mode != PHP_DRIVER_FUTURES_ANY)
+    array_init_size(return_value, count);
+
+  ZEND_HASH_FOREACH_KEY_VAL(futures, index, key, future) {
+    entries[i].index  = index;
+    entries[i].key    = key;
+    entries[i].future = future;
+    entries[i].native = php_driver_futures_native(future, &entries[i].state);
+
+    /* Results of all() keep the order of the given futures */
+    if (mode == PHP_DRIVER_FUTURES_ALL) {
+      zval placeholder;
+      ZVAL_NULL(&placeholder);
+      if (key)
+        zend_hash_add_new(Z_ARRVAL_P(return_value), key, &placeholder);
+      else
+        zend_hash_index_add_new(Z_ARRVAL_P(return_value), index, &placeholder);
+    }
+    i++;
+  } ZEND_HASH_FOREACH_END();
+
+  ZVAL_UNDEF(&last_error);
+  deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+
+  /* Completions are queued before anything is resolved so that none is missed */
+  for (i = 0; i < count; i++) {
+    if (entries[i].native)
+      php_driver_future_queue_watch(&queue, entries[i].state);
+  }
+
+  /* Returns 1 once the result of the wait is known */
+  auto resolve = [&](php_driver_futures_entry *entry) -> int {
+    zval value;
+
+    ZVAL_UNDEF(&value);
+    if (entry->native || timeout_us == 0) {
+      zend_call_method_with_0_params(Z_OBJ_P(entry->future), Z_OBJCE_P(entry->future), NULL,
+                                     "get", &value);
+    } else {
+      /* Other futures block in get(), bound them by what is left of the deadline */
+      zval left;
+      ZVAL_DOUBLE(&left, MAX(std::chrono::duration<double>(
+                                 deadline - std::chrono::steady_clock::now()).count(),
+                             0.000001));
+      zend_call_method_with_1_params(Z_OBJ_P(entry->future), Z_OBJCE_P(entry->future), NULL,
+                                     "get", &value, &left);
+    }
+    entry->done = 1;
+    remaining--;
+
+    if (EG(exception)) {
+      zval_ptr_dtor(&value);
+
+      if (mode == PHP_DRIVER_FUTURES_ALL) {
+        zval_ptr_dtor(return_value);
+        ZVAL_NULL(return_value);
+        return 1;
+      }
+
+      PHP5TO7_ZVAL_MAYBE_DESTROY(last_error);
+      ZVAL_OBJ(&last_error, EG(exception));
+      GC_ADDREF(EG(exception));
+      zend_clear_exception();
+
+      if (mode != PHP_DRIVER_FUTURES_SETTLED)
+        return 0;
+
+      ZVAL_COPY(&value, &last_error);
+    } else if (mode == PHP_DRIVER_FUTURES_ANY) {
+      RETVAL_ZVAL(&value, 0, 0);
+      return 1;
+    }
+
+    if (entry->key)
+      zend_hash_update(Z_ARRVAL_P(return_value), entry->key, &value);
+    else
+      zend_hash_index_update(Z_ARRVAL_P(return_value), entry->index, &value);
+    return 0;
+  };
+
+  /* Futures that are already resolved are taken in the given order */
+  for (i = 0; i < count; i++) {
+    if (entries[i].native && !cass_future_ready(entries[i].native))
+      continue;
+    if (resolve(&entries[i]))
+      goto cleanup;
+  }
+
+  /* The others in the order they complete */
+  while (remaining > 0) {
+    CassFuture *completed;
+    cass_duration_t wait_us = 0;
+
+    if (timeout_us > 0) {
+      std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+      if (now >= deadline) {
+        if (mode != PHP_DRIVER_FUTURES_ANY) {
+          zval_ptr_dtor(return_value);
+          ZVAL_NULL(return_value);
+        }
+        zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
+                                "Futures haven't resolved within %f seconds",
+                                timeout_us / 1000000.0);
+        goto cleanup;
+      }
+
+      wait_us = MAX((cass_duration_t) std::chrono::duration_cast<std::chrono::microseconds>(
+                        deadline - now).count(),
+                    1);
+    }
+
+    completed = php_driver_future_queue_next(&queue, wait_us);
+    if (!completed)
+      continue;
+
+    /* The same future may be given more than once */
+    for (i = 0; i < count; i++) {
+      if (entries[i].done || entries[i].native != completed)
+        continue;
+      if (resolve(&entries[i]))
+        goto cleanup;
+    }
+  }
+
+  /* Every future of any() has failed, report the last failure */
+  if (mode == PHP_DRIVER_FUTURES_ANY && !Z_ISUNDEF(last_error)) {
+    zend_throw_exception_object(&last_error);
+    ZVAL_UNDEF(&last_error);
+  }
+
+cleanup:
+  php_driver_future_queue_close(&queue);
+  PHP5TO7_ZVAL_MAYBE_DESTROY(last_error);
+  efree(entries);
+}
+
+PHP_METHOD(Futures, all)
+{
+  zval *futures;
+  zval *timeout = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|z", &futures, &timeout) == FAILURE) {
+    return;
+  }
+
+  php_driver_futures_wait(Z_ARRVAL_P(futures), timeout, PHP_DRIVER_FUTURES_ALL, return_value);
+}
+
+PHP_METHOD(Futures, any)
+{
+  zval *futures;
+  zval *timeout = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|z", &futures, &timeout) == FAILURE) {
+    return;
+  }
+
+  php_driver_futures_wait(Z_ARRVAL_P(futures), timeout, PHP_DRIVER_FUTURES_ANY, return_value);
+}
+
+PHP_METHOD(Futures, settled)
+{
+  zval *futures;
+  zval *timeout = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "a|z", &futures, &timeout) == FAILURE) {
+    return;
+  }
+
+  php_driver_futures_wait(Z_ARRVAL_P(futures), timeout, PHP_DRIVER_FUTURES_SETTLED, return_value);
+}
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_futures, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, futures)
+  ZEND_ARG_INFO(0, timeout)
+ZEND_END_ARG_INFO()
+
+static zend_function_entry php_driver_futures_methods[] = {
+  PHP_ME(Futures, all, arginfo_futures, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+  PHP_ME(Futures, any, arginfo_futures, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+  PHP_ME(Futures, settled, arginfo_futures, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+  PHP_FE_END
+};
+
+void php_driver_define_Futures()
+{
+  zend_class_entry ce;
+
+  INIT_CLASS_ENTRY(ce, PHP_DRIVER_NAMESPACE "\\Futures", php_driver_futures_methods);
+  php_driver_futures_ce = zend_register_internal_class(&ce );
+  php_driver_futures_ce->ce_flags |= ZEND_ACC_FINAL;
+}
+END_EXTERN_C()
@@ -24,10 +24,24 @@
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_map_ce = NULL;
 
+static void
+php_driver_map_store(php_driver_map *map, zval *zkey, zval *zvalue)
+{
+  zend_bool added;
+  php_driver_flat_entry *entry = php_driver_flat_hash_add(&map->entries, zkey, &added, &map->iter_pos);
+
+  if (added) {
+    ZVAL_COPY(&entry->value, zvalue);
+  } else {
+    zval prev_value = entry->value;
+    ZVAL_COPY(&entry->value, zvalue);
+    zval_ptr_dtor(&prev_value);
+  }
+}
+
 int
 php_driver_map_set(php_driver_map *map, zval *zkey, zval *zvalue )
 {
-  php_driver_map_entry *entry;
   php_driver_type *type;
 
   if (Z_TYPE_P(zkey) == IS_NULL) {
@@ -52,18 +66,8 @@ php_driver_map_set(php_driver_map *map, zval *zkey, zval *zvalue )
     return 0;
   }
 
-  map->dirty = 1;
-  HASH_FIND_ZVAL(map->entries, zkey, entry);
-  if (entry == NULL) {
-    entry = (php_driver_map_entry *) emalloc(sizeof(php_driver_map_entry));
-    ZVAL_COPY(&entry->key, zkey);
-    ZVAL_COPY(&entry->value, zvalue);
-    HASH_ADD_ZVAL(map->entries, key, entry);
-  } else {
-    zval prev_value = entry->value;
-    ZVAL_COPY(&entry->value, zvalue);
-    zval_ptr_dtor(&prev_value);
-  }
+  PHP_DRIVER_VALUE_MUTATED(map);
+  php_driver_map_store(map, zkey, zvalue);
 
   return 1;
 }
@@ -71,7 +75,7 @@ php_driver_map_set(php_driver_map *map, zval *zkey, zval *zvalue )
 static int
 php_driver_map_get(php_driver_map *map, zval *zkey, zval *zvalue )
 {
-  php_driver_map_entry *entry;
+  php_driver_flat_entry *entry;
   php_driver_type *type;
   int result = 0;
 
@@ -81,7 +85,7 @@ php_driver_map_get(php_driver_map *map, zval *zkey, zval *zvalue )
     return 0;
   }
 
-  HASH_FIND_ZVAL(map->entries, zkey, entry);
+  entry = php_driver_flat_hash_find(&map->entries, zkey);
   if (entry != NULL) {
     *zvalue = entry->value;
     result = 1;
@@ -93,7 +97,6 @@ php_driver_map_get(php_driver_map *map, zval *zkey, zval *zvalue )
 static int
 php_driver_map_del(php_driver_map *map, zval *zkey )
 {
-  php_driver_map_entry *entry;
   php_driver_type *type;
   int result = 0;
 
@@ -103,16 +106,8 @@ php_driver_map_del(php_driver_map *map, zval *zkey )
     return 0;
   }
 
-  HASH_FIND_ZVAL(map->entries, zkey, entry);
-  if (entry != NULL) {
-    map->dirty = 1;
-    if (entry == map->iter_temp) {
-      map->iter_temp = (php_driver_map_entry *)map->iter_temp->hh.next;
-    }
-    HASH_DEL(map->entries, entry);
-    zval_ptr_dtor(&entry->key);
-    zval_ptr_dtor(&entry->value);
-    efree(entry);
+  if (php_driver_flat_hash_del(&map->entries, zkey)) {
+    PHP_DRIVER_VALUE_MUTATED(map);
     result = 1;
   }
 
@@ -122,7 +117,6 @@ php_driver_map_del(php_driver_map *map, zval *zkey )
 static int
 php_driver_map_has(php_driver_map *map, zval *zkey )
 {
-  php_driver_map_entry *entry;
   php_driver_type *type;
   int result = 0;
 
@@ -132,8 +126,7 @@ php_driver_map_has(php_driver_map *map, zval *zkey )
     return 0;
   }
 
-  HASH_FIND_ZVAL(map->entries, zkey, entry);
-  if (entry != NULL) {
+  if (php_driver_flat_hash_find(&map->entries, zkey) != NULL) {
     result = 1;
   }
 
@@ -143,8 +136,8 @@ php_driver_map_has(php_driver_map *map, zval *zkey )
 static void
 php_driver_map_populate_keys(const php_driver_map *map, zval *array )
 {
-  php_driver_map_entry *curr,  *temp;
-  HASH_ITER(hh, map->entries, curr, temp) {
+  php_driver_flat_entry *curr;
+  PHP_DRIVER_FLAT_HASH_FOREACH(&map->entries, curr) {
     if (add_next_index_zval(array, &curr->key) != SUCCESS) {
       break;
     }
@@ -155,8 +148,8 @@ php_driver_map_populate_keys(const php_driver_map *map, zval *array )
 static void
 php_driver_map_populate_values(const php_driver_map *map, zval *array )
 {
-  php_driver_map_entry *curr, *temp;
-  HASH_ITER(hh, map->entries, curr, temp) {
+  php_driver_flat_entry *curr;
+  PHP_DRIVER_FLAT_HASH_FOREACH(&map->entries, curr) {
     if (add_next_index_zval(array, &curr->value) != SUCCESS) {
       break;
     }
@@ -164,52 +157,44 @@ php_driver_map_populate_values(const php_driver_map *map, zval *array )
   }
 }
 
-/* {{{ Map::__construct(type, type) */
-PHP_METHOD(Map, __construct)
+static int
+php_driver_map_init_type(php_driver_map *map, zval *key_type, zval *value_type)
 {
-  php_driver_map *self;
-  zval *key_type;
-  zval *value_type;
   zval scalar_key_type;
   zval scalar_value_type;
 
   ZVAL_UNDEF(&scalar_key_type);
   ZVAL_UNDEF(&scalar_value_type);
 
-  if (zend_parse_parameters(ZEND_NUM_ARGS() , "zz", &key_type, &value_type) == FAILURE)
-    return;
-
-  self = PHP_DRIVER_GET_MAP(getThis());
-
   if (Z_TYPE_P(key_type) == IS_STRING) {
     CassValueType type;
     if (!php_driver_value_type(Z_STRVAL_P(key_type), &type ))
-      return;
+      return 0;
     scalar_key_type = php_driver_type_scalar(type );
     key_type = &scalar_key_type;
   } else if (Z_TYPE_P(key_type) == IS_OBJECT &&
              instanceof_function(Z_OBJCE_P(key_type), php_driver_type_ce )) {
     if (!php_driver_type_validate(key_type, "keyType" )) {
-      return;
+      return 0;
     }
     Z_ADDREF_P(key_type);
   } else {
     throw_invalid_argument(key_type,
                            "keyType",
                            "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Type" );
-    return;
+    return 0;
   }
 
   if (Z_TYPE_P(value_type) == IS_STRING) {
     CassValueType type;
     if (!php_driver_value_type(Z_STRVAL_P(value_type), &type ))
-      return;
+      return 0;
     scalar_value_type = php_driver_type_scalar(type );
     value_type = &scalar_value_type;
   } else if (Z_TYPE_P(value_type) == IS_OBJECT &&
              instanceof_function(Z_OBJCE_P(value_type), php_driver_type_ce )) {
     if (!php_driver_type_validate(value_type, "valueType" )) {
-      return;
+      return 0;
     }
     Z_ADDREF_P(value_type);
   } else {
@@ -217,10 +202,151 @@ PHP_METHOD(Map, __construct)
     throw_invalid_argument(value_type,
                            "valueType",
                            "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Type" );
+    return 0;
+  }
+
+  map->type = php_driver_type_map(key_type, value_type );
+
+  return 1;
+}
+
+static int
+php_driver_map_add_assoc(php_driver_map *map, HashTable *values)
+{
+  php_driver_type *type = PHP_DRIVER_GET_TYPE(&map->type);
+  php_driver_type *key_type = PHP_DRIVER_GET_TYPE(&type->data.map.key_type);
+  int text_keys = key_type->type == CASS_VALUE_TYPE_VARCHAR ||
+                  key_type->type == CASS_VALUE_TYPE_TEXT ||
+                  key_type->type == CASS_VALUE_TYPE_ASCII;
+  zend_ulong num_key;
+  zend_string *str_key;
+  zval *current;
+
+  /* PHP turns numeric string keys into integers, which are converted back to
+   * strings for text keys */
+  ZEND_HASH_FOREACH_KEY_VAL(values, num_key, str_key, current) {
+    zval key;
+
+    if (str_key) {
+      ZVAL_STR(&key, str_key);
+    } else if (text_keys) {
+      ZVAL_STR(&key, zend_long_to_str((zend_long) num_key));
+    } else {
+      ZVAL_LONG(&key, (zend_long) num_key);
+    }
+
+    if (!text_keys && !php_driver_validate_object(&key, &type->data.map.key_type)) {
+      return 0;
+    }
+
+    ZVAL_DEREF(current);
+    php_driver_map_store(map, &key, current);
+
+    if (!str_key && text_keys) {
+      zval_ptr_dtor(&key);
+    }
+  } ZEND_HASH_FOREACH_END();
+
+  return 1;
+}
+
+/* {{{ Map::__construct(type, type) */
+PHP_METHOD(Map, __construct)
+{
+  zval *key_type;
+  zval *value_type;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() , "zz", &key_type, &value_type) == FAILURE)
+    return;
+
+  php_driver_map_init_type(PHP_DRIVER_GET_MAP(getThis()), key_type, value_type);
+}
+/* }}} */
+
+/* {{{ Map::fromArrays(keyType, valueType, keys, values) */
+PHP_METHOD(Map, fromArrays)
+{
+  php_driver_map *map;
+  php_driver_type *type;
+  zval *key_type;
+  zval *value_type;
+  HashTable *keys;
+  HashTable *values;
+  HashPosition pos;
+  zval *current;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() , "zzhh", &key_type, &value_type, &keys, &values) == FAILURE)
+    return;
+
+  if (zend_hash_num_elements(keys) != zend_hash_num_elements(values)) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0 ,
+                            "Keys and values must have the same number of elements, %d keys and %d values given",
+                            zend_hash_num_elements(keys), zend_hash_num_elements(values));
     return;
   }
 
-  self->type = php_driver_type_map(key_type, value_type );
+  object_init_ex(return_value, php_driver_map_ce);
+  map = PHP_DRIVER_GET_MAP(return_value);
+
+  if (!php_driver_map_init_type(map, key_type, value_type)) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  type = PHP_DRIVER_GET_TYPE(&map->type);
+
+  if (!php_driver_validate_array(keys, &type->data.map.key_type, "key", "maps") ||
+      !php_driver_validate_array(values, &type->data.map.value_type, "value", "maps")) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  php_driver_flat_hash_reserve(&map->entries, zend_hash_num_elements(keys));
+
+  zend_hash_internal_pointer_reset_ex(values, &pos);
+  ZEND_HASH_FOREACH_VAL(keys, current) {
+    zval *value = zend_hash_get_current_data_ex(values, &pos);
+    ZVAL_DEREF(current);
+    ZVAL_DEREF(value);
+    php_driver_map_store(map, current, value);
+    zend_hash_move_forward_ex(values, &pos);
+  } ZEND_HASH_FOREACH_END();
+}
+/* }}} */
+
+/* {{{ Map::fromAssoc(keyType, valueType, values) */
+PHP_METHOD(Map, fromAssoc)
+{
+  php_driver_map *map;
+  php_driver_type *type;
+  zval *key_type;
+  zval *value_type;
+  HashTable *values;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() , "zzh", &key_type, &value_type, &values) == FAILURE)
+    return;
+
+  object_init_ex(return_value, php_driver_map_ce);
+  map = PHP_DRIVER_GET_MAP(return_value);
+
+  if (!php_driver_map_init_type(map, key_type, value_type)) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  type = PHP_DRIVER_GET_TYPE(&map->type);
+
+  if (!php_driver_validate_array(values, &type->data.map.value_type, "value", "maps")) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  php_driver_flat_hash_reserve(&map->entries, zend_hash_num_elements(values));
+
+  if (!php_driver_map_add_assoc(map, values)) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
 }
 /* }}} */
 
@@ -315,41 +441,39 @@ PHP_METHOD(Map, has)
 PHP_METHOD(Map, count)
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(getThis());
-  RETURN_LONG((long)HASH_COUNT(self->entries));
+  RETURN_LONG((long)self->entries.count);
 }
 
 PHP_METHOD(Map, current)
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(getThis());
-  if (self->iter_curr != NULL)
-    RETURN_ZVAL(&self->iter_curr->value, 1, 0);
+  if (self->iter_pos < self->entries.used && !Z_ISUNDEF(self->entries.entries[self->iter_pos].key))
+    RETURN_ZVAL(&self->entries.entries[self->iter_pos].value, 1, 0);
 }
 
 PHP_METHOD(Map, key)
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(getThis());
-  if (self->iter_curr != NULL)
-    RETURN_ZVAL(&self->iter_curr->key, 1, 0);
+  if (self->iter_pos < self->entries.used && !Z_ISUNDEF(self->entries.entries[self->iter_pos].key))
+    RETURN_ZVAL(&self->entries.entries[self->iter_pos].key, 1, 0);
 }
 
 PHP_METHOD(Map, next)
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(getThis());
-  self->iter_curr = self->iter_temp;
-  self->iter_temp = self->iter_temp != NULL ? (php_driver_map_entry *)self->iter_temp->hh.next : NULL;
+  self->iter_pos = php_driver_flat_hash_next(&self->entries, self->iter_pos + 1);
 }
 
 PHP_METHOD(Map, valid)
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(getThis());
-  RETURN_BOOL(self->iter_curr != NULL);
+  RETURN_BOOL(self->iter_pos < self->entries.used);
 }
 
 PHP_METHOD(Map, rewind)
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(getThis());
-  self->iter_curr = self->entries;
-  self->iter_temp = self->entries != NULL ? (php_driver_map_entry *)self->entries->hh.next : NULL;
+  self->iter_pos = php_driver_flat_hash_next(&self->entries, 0);
 }
 
 PHP_METHOD(Map, offsetSet)
@@ -415,6 +539,19 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 2)
   ZEND_ARG_INFO(0, valueType)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_from_arrays, 0, ZEND_RETURN_VALUE, 4)
+  ZEND_ARG_INFO(0, keyType)
+  ZEND_ARG_INFO(0, valueType)
+  ZEND_ARG_TYPE_INFO(0, keys, IS_ARRAY, 0)
+  ZEND_ARG_TYPE_INFO(0, values, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_from_assoc, 0, ZEND_RETURN_VALUE, 3)
+  ZEND_ARG_INFO(0, keyType)
+  ZEND_ARG_INFO(0, valueType)
+  ZEND_ARG_TYPE_INFO(0, values, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_two, 0, ZEND_RETURN_VALUE, 2)
   ZEND_ARG_INFO(0, key)
   ZEND_ARG_INFO(0, value)
@@ -464,6 +601,8 @@ ZEND_END_ARG_INFO()
 
 static zend_function_entry php_driver_map_methods[] = {
   PHP_ME(Map, __construct, arginfo__construct, ZEND_ACC_CTOR|ZEND_ACC_PUBLIC)
+  PHP_ME(Map, fromArrays, arginfo_from_arrays, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+  PHP_ME(Map, fromAssoc, arginfo_from_assoc, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
   PHP_ME(Map, type, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(Map, keys, arginfo_none, ZEND_ACC_PUBLIC)
   PHP_ME(Map, values, arginfo_none, ZEND_ACC_PUBLIC)
@@ -544,13 +683,16 @@ php_driver_map_properties(
   return props;
 }
 
+static unsigned
+php_driver_map_hash_value(zval *obj );
+
 static int
 php_driver_map_compare(zval *obj1, zval *obj2 )
 {
 #if PHP_MAJOR_VERSION >= 8
   ZEND_COMPARE_OBJECTS_FALLBACK(obj1, obj2);
 #endif
-  php_driver_map_entry *curr, *temp;
+  php_driver_flat_entry *curr;
   php_driver_map *map1;
   php_driver_map *map2;
   php_driver_type *type1;
@@ -569,13 +711,17 @@ php_driver_map_compare(zval *obj1, zval *obj2 )
   result = php_driver_type_compare(type1, type2 );
   if (result != 0) return result;
 
-  if (HASH_COUNT(map1->entries) != HASH_COUNT(map2->entries)) {
-   return HASH_COUNT(map1->entries) < HASH_COUNT(map2->entries) ? -1 : 1;
+  if (map1->entries.count != map2->entries.count) {
+   return map1->entries.count < map2->entries.count ? -1 : 1;
+  }
+
+  if (php_driver_map_hash_value(obj1 ) != php_driver_map_hash_value(obj2 )) {
+    return 1;
   }
 
-  HASH_ITER(hh, map1->entries, curr, temp) {
-    php_driver_map_entry *entry = NULL;
-    HASH_FIND_ZVAL(map2->entries, &curr->key, entry);
+  PHP_DRIVER_FLAT_HASH_FOREACH(&map1->entries, curr) {
+    php_driver_flat_entry *entry =
+        php_driver_flat_hash_find_hash(&map2->entries, &curr->key, curr->hash);
     if (entry == NULL) {
       return 1;
     }
@@ -591,20 +737,26 @@ static unsigned
 php_driver_map_hash_value(zval *obj )
 {
   php_driver_map *self = PHP_DRIVER_GET_MAP(obj);
-  php_driver_map_entry *curr, *temp;
+  php_driver_flat_entry *curr;
   unsigned hashv = 0;
-
-  if (!self->dirty) return self->hashv;
-
-  HASH_ITER(hh, self->entries, curr, temp) {
-    hashv = php_driver_combine_hash(hashv,
-                                       php_driver_value_hash(&curr->key ));
-    hashv = php_driver_combine_hash(hashv,
-                                       php_driver_value_hash(&curr->value ));
+  zend_bool nested = 0;
+  zend_ulong version = 0;
+
+  if (PHP_DRIVER_HASH_CACHED(self, php_driver_flat_nested_hash_cached(&self->entries, self->hash_version)))
+    return self->hashv;
+
+  /* Entries are summed so that equal maps hash the same whatever order their
+   * keys were set in */
+  PHP_DRIVER_FLAT_HASH_FOREACH(&self->entries, curr) {
+    hashv += php_driver_combine_hash(curr->hash,
+                                     php_driver_value_hash(&curr->value ));
+    if (php_driver_value_is_nested(&curr->value)) {
+      nested = 1;
+      version += php_driver_value_version(&curr->value);
+    }
   }
 
-  self->hashv = hashv;
-  self->dirty = 0;
+  PHP_DRIVER_HASH_STORE(self, hashv, nested, version);
 
   return hashv;
 }
@@ -613,14 +765,8 @@ static void
 php_driver_map_free(zend_object *object )
 {
   php_driver_map *self = PHP5TO7_ZEND_OBJECT_GET(map, object);
-  php_driver_map_entry *curr, *temp;
 
-  HASH_ITER(hh, self->entries, curr, temp) {
-    zval_ptr_dtor(&curr->key);
-    zval_ptr_dtor(&curr->value);
-    HASH_DEL(self->entries, curr);
-    efree(curr);
-  }
+  php_driver_flat_hash_destroy(&self->entries);
 
   PHP5TO7_ZVAL_MAYBE_DESTROY(self->type);
 
@@ -634,7 +780,8 @@ php_driver_map_new(zend_class_entry *ce )
   php_driver_map *self =
       PHP5TO7_ZEND_OBJECT_ECALLOC(map, ce);
 
-  self->entries = self->iter_curr = self->iter_temp = NULL;
+  php_driver_flat_hash_init(&self->entries);
+  self->iter_pos = 0;
   self->dirty = 1;
   ZVAL_UNDEF(&self->type);
 
@@ -16,6 +16,9 @@
 
 #include "php_driver.h"
 #include "php_driver_types.h"
+#include "src/BoundStatement.h"
+#include "util/bind.h"
+#include "util/ref.h"
 BEGIN_EXTERN_C()
 zend_class_entry *php_driver_prepared_statement_ce = NULL;
 
@@ -23,11 +26,35 @@ PHP_METHOD(PreparedStatement, __construct)
 {
 }
 
+PHP_METHOD(PreparedStatement, bind)
+{
+  zval *arguments = NULL;
+  zval *options = NULL;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS(), "|a!z", &arguments, &options) == FAILURE) {
+    return;
+  }
+
+  object_init_ex(return_value, php_driver_bound_statement_ce);
+
+  if (php_driver_bound_statement_init(PHP_DRIVER_GET_STATEMENT(return_value), getThis(),
+                                      arguments, options) == FAILURE) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+}
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_bind, 0, ZEND_RETURN_VALUE, 0)
+  ZEND_ARG_INFO(0, arguments)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 static zend_function_entry php_driver_prepared_statement_methods[] = {
   PHP_ME(PreparedStatement, __construct, arginfo_none, ZEND_ACC_PRIVATE | ZEND_ACC_CTOR)
+  PHP_ME(PreparedStatement, bind, arginfo_bind, ZEND_ACC_PUBLIC)
   PHP_FE_END
 };
 
@@ -67,6 +94,11 @@ php_driver_prepared_statement_free(zend_object *object )
   if (self->data.prepared.prepared)
     cass_prepared_free(self->data.prepared.prepared);
 
+  php_driver_del_ref(&self->data.prepared.columns);
+
+  if (self->data.prepared.parameters)
+    php_driver_bind_parameters_free(self->data.prepared.parameters);
+
   zend_object_std_dtor(&self->zendObject);
 
 }
@@ -79,6 +111,8 @@ php_driver_prepared_statement_new(zend_class_entry *ce )
 
   self->type = PHP_DRIVER_PREPARED_STATEMENT;
   self->data.prepared.prepared = NULL;
+  self->data.prepared.columns = NULL;
+  self->data.prepared.parameters = NULL;
 
   PHP5TO7_ZEND_OBJECT_INIT_EX(statement, prepared_statement, self, ce);
 }
@@ -23,26 +23,56 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_execute, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execute_concurrent, 0, ZEND_RETURN_VALUE, 2)
+  ZEND_ARG_INFO(0, statement)
+  ZEND_ARG_INFO(0, arguments)
+  ZEND_ARG_INFO(0, concurrency)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_execute_grouped, 0, ZEND_RETURN_VALUE, 3)
+  PHP_DRIVER_NAMESPACE_ZEND_ARG_OBJ_INFO(0, statement, PreparedStatement, 0)
+  ZEND_ARG_INFO(0, rows)
+  ZEND_ARG_INFO(0, partitionKey)
+  ZEND_ARG_INFO(0, batchSize)
+  ZEND_ARG_INFO(0, concurrency)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare, 0, ZEND_RETURN_VALUE, 1)
   ZEND_ARG_INFO(0, cql)
   ZEND_ARG_INFO(0, options)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_prepare_all, 0, ZEND_RETURN_VALUE, 1)
+  ZEND_ARG_INFO(0, cqls)
+  ZEND_ARG_INFO(0, options)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_timeout, 0, ZEND_RETURN_VALUE, 0)
   ZEND_ARG_INFO(0, timeout)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_metrics, 0, ZEND_RETURN_VALUE, 0)
+  ZEND_ARG_INFO(0, flat)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_none, 0, ZEND_RETURN_VALUE, 0)
 ZEND_END_ARG_INFO()
 
 static zend_function_entry php_driver_session_methods[] = {
   PHP_ABSTRACT_ME(Session, execute, arginfo_execute)
   PHP_ABSTRACT_ME(Session, executeAsync, arginfo_execute)
+  PHP_ABSTRACT_ME(Session, executeStream, arginfo_execute)
+  PHP_ABSTRACT_ME(Session, executeConcurrent, arginfo_execute_concurrent)
+  PHP_ABSTRACT_ME(Session, executeGrouped, arginfo_execute_grouped)
   PHP_ABSTRACT_ME(Session, prepare, arginfo_prepare)
   PHP_ABSTRACT_ME(Session, prepareAsync, arginfo_prepare)
+  PHP_ABSTRACT_ME(Session, prepareAll, arginfo_prepare_all)
   PHP_ABSTRACT_ME(Session, close, arginfo_timeout)
   PHP_ABSTRACT_ME(Session, closeAsync, arginfo_none)
-  PHP_ABSTRACT_ME(Session, metrics, arginfo_none)
+  PHP_ABSTRACT_ME(Session, metrics, arginfo_metrics)
+  PHP_ABSTRACT_ME(Session, warmupStatus, arginfo_none)
   PHP_ABSTRACT_ME(Session, schema, arginfo_none)
   PHP_FE_END
 };
@@ -28,8 +28,8 @@ zend_class_entry* php_driver_set_ce = NULL;
 int
 php_driver_set_add(php_driver_set* set, zval* object )
 {
-  php_driver_set_entry* entry;
   php_driver_type* type;
+  zend_bool added;
 
   if (Z_TYPE_P(object) == IS_NULL) {
     zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0 ,
@@ -43,12 +43,9 @@ php_driver_set_add(php_driver_set* set, zval* object )
     return 0;
   }
 
-  HASH_FIND_ZVAL(set->entries, object, entry);
-  if (entry == NULL) {
-    set->dirty = 1;
-    entry      = (php_driver_set_entry*) emalloc(sizeof(php_driver_set_entry));
-    ZVAL_COPY(&entry->value, object);
-    HASH_ADD_ZVAL(set->entries, value, entry);
+  php_driver_flat_hash_add(&set->entries, object, &added, &set->iter_pos);
+  if (added) {
+    PHP_DRIVER_VALUE_MUTATED(set);
   }
 
   return 1;
@@ -57,7 +54,6 @@ php_driver_set_add(php_driver_set* set, zval* object )
 static int
 php_driver_set_del(php_driver_set* set, zval* object )
 {
-  php_driver_set_entry* entry;
   php_driver_type* type;
   int result = 0;
 
@@ -67,15 +63,8 @@ php_driver_set_del(php_driver_set* set, zval* object )
     return 0;
   }
 
-  HASH_FIND_ZVAL(set->entries, object, entry);
-  if (entry != NULL) {
-    set->dirty = 1;
-    if (entry == set->iter_temp) {
-      set->iter_temp = (php_driver_set_entry*) set->iter_temp->hh.next;
-    }
-    HASH_DEL(set->entries, entry);
-    zval_ptr_dtor(&entry->value);
-    efree(entry);
+  if (php_driver_flat_hash_del(&set->entries, object)) {
+    PHP_DRIVER_VALUE_MUTATED(set);
     result = 1;
   }
 
@@ -85,7 +74,6 @@ php_driver_set_del(php_driver_set* set, zval* object )
 static int
 php_driver_set_has(php_driver_set* set, zval* object )
 {
-  php_driver_set_entry* entry;
   php_driver_type* type;
   int result = 0;
 
@@ -95,8 +83,7 @@ php_driver_set_has(php_driver_set* set, zval* object )
     return 0;
   }
 
-  HASH_FIND_ZVAL(set->entries, object, entry);
-  if (entry != NULL) {
+  if (php_driver_flat_hash_find(&set->entries, object) != NULL) {
     result = 1;
   }
 
@@ -106,41 +93,83 @@ php_driver_set_has(php_driver_set* set, zval* object )
 static void
 php_driver_set_populate(php_driver_set* set, zval* array )
 {
-  php_driver_set_entry *curr, *temp;
-  HASH_ITER(hh, set->entries, curr, temp)
+  php_driver_flat_entry* curr;
+  PHP_DRIVER_FLAT_HASH_FOREACH(&set->entries, curr)
   {
-    if (add_next_index_zval(array, &curr->value) != SUCCESS) {
+    if (add_next_index_zval(array, &curr->key) != SUCCESS) {
       break;
     }
-    Z_TRY_ADDREF_P(&curr->value);
+    Z_TRY_ADDREF_P(&curr->key);
   }
 }
 
-/* {{{ Set::__construct(type) */
-PHP_METHOD(Set, __construct)
+static int
+php_driver_set_init_type(php_driver_set* set, zval* type)
 {
-  php_driver_set* self;
-  zval* type;
-
-  if (zend_parse_parameters(ZEND_NUM_ARGS() , "z", &type) == FAILURE)
-    return;
-
-  self = PHP_DRIVER_GET_SET(getThis());
-
   if (Z_TYPE_P(type) == IS_STRING) {
     CassValueType value_type;
     if (!php_driver_value_type(Z_STRVAL_P(type), &value_type ))
-      return;
-    self->type = php_driver_type_set_from_value_type(value_type );
+      return 0;
+    set->type = php_driver_type_set_from_value_type(value_type );
   } else if (Z_TYPE_P(type) == IS_OBJECT && instanceof_function(Z_OBJCE_P(type), php_driver_type_ce )) {
     if (!php_driver_type_validate(type, "type" )) {
-      return;
+      return 0;
     }
-    self->type = php_driver_type_set(type );
+    set->type = php_driver_type_set(type );
     Z_ADDREF_P(type);
   } else {
-    INVALID_ARGUMENT(type, "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Type");
+    throw_invalid_argument(type, "type", "a string or an instance of " PHP_DRIVER_NAMESPACE "\\Type");
+    return 0;
   }
+
+  return 1;
+}
+
+/* {{{ Set::__construct(type) */
+PHP_METHOD(Set, __construct)
+{
+  zval* type;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() , "z", &type) == FAILURE)
+    return;
+
+  php_driver_set_init_type(PHP_DRIVER_GET_SET(getThis()), type);
+}
+/* }}} */
+
+/* {{{ Set::fromArray(type, values) */
+PHP_METHOD(Set, fromArray)
+{
+  php_driver_set* set;
+  php_driver_type* type;
+  zval* ztype;
+  HashTable* values;
+  zval* current;
+
+  if (zend_parse_parameters(ZEND_NUM_ARGS() , "zh", &ztype, &values) == FAILURE)
+    return;
+
+  object_init_ex(return_value, php_driver_set_ce);
+  set = PHP_DRIVER_GET_SET(return_value);
+
+  if (!php_driver_set_init_type(set, ztype)) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  type = PHP_DRIVER_GET_TYPE(&set->type);
+
+  if (!php_driver_validate_array(values, &type->data.set.value_type, "value", "sets")) {
+    zval_ptr_dtor(return_value);
+    RETURN_NULL();
+  }
+
+  php_driver_flat_hash_reserve(&set->entries, zend_hash_num_elements(values));
+
+  ZEND_HASH_FOREACH_VAL(values, current) {
+    ZVAL_DEREF(current);
+    php_driver_flat_hash_add(&set->entries, current, NULL, NULL);
+  } ZEND_HASH_FOREACH_END();
 }
 /* }}} */
 
@@ -220,7 +249,7 @@ PHP_METHOD(Set, has)
 PHP_METHOD(Set, count)
 {
   php_driver_set* self = PHP_DRIVER_GET_SET(getThis());
-  RETURN_LONG((long) HASH_COUNT(self->entries));
+  RETURN_LONG((long) self->entries.count);
 }
 /* }}} */
 
@@ -228,8 +257,8 @@ PHP_METHOD(Set, count)
 PHP_METHOD(Set, current)
 {
   php_driver_set* self = PHP_DRIVER_GET_SET(getThis());
-  if (self->iter_curr != NULL)
-    RETURN_ZVAL(&self->iter_curr->value, 1, 0);
+  if (self->iter_pos < self->entries.used && !Z_ISUNDEF(self->entries.entries[self->iter_pos].key))
+    RETURN_ZVAL(&self->entries.entries[self->iter_pos].key, 1, 0);
 }
 /* }}} */
 
@@ -245,8 +274,7 @@ PHP_METHOD(Set, key)
 PHP_METHOD(Set, next)
 {
   php_driver_set* self = PHP_DRIVER_GET_SET(getThis());
-  self->iter_curr      = self->iter_temp;
-  self->iter_temp      = self->iter_temp != NULL ? (php_driver_set_entry*) self->iter_temp->hh.next : NULL;
+  self->iter_pos       = php_driver_flat_hash_next(&self->entries, self->iter_pos + 1);
   self->iter_index++;
 }
 /* }}} */
@@ -255,7 +283,7 @@ PHP_METHOD(Set, next)
 PHP_METHOD(Set, valid)
 {
   php_driver_set* self = PHP_DRIVER_GET_SET(getThis());
-  RETURN_BOOL(self->iter_curr != NULL);
+  RETURN_BOOL(self->iter_pos < self->entries.used);
 }
 /* }}} */
 
@@ -263,8 +291,7 @@ PHP_METHOD(Set, valid)
 PHP_METHOD(Set, rewind)
 {
   php_driver_set* self = PHP_DRIVER_GET_SET(getThis());
-  self->iter_curr      = self->entries;
-  self->iter_temp      = self->entries != NULL ? (php_driver_set_entry*) self->entries->hh.next : NULL;
+  self->iter_pos       = php_driver_flat_hash_next(&self->entries, 0);
   self->iter_index     = 0;
 }
 /* }}} */
@@ -273,6 +300,11 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo__construct, 0, ZEND_RETURN_VALUE, 1)
 ZEND_ARG_INFO(0, type)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_from_array, 0, ZEND_RETURN_VALUE, 2)
+ZEND_ARG_INFO(0, type)
+ZEND_ARG_TYPE_INFO(0, values, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_one, 0, ZEND_RETURN_VALUE, 1)
 ZEND_ARG_INFO(0, value)
 ZEND_END_ARG_INFO()
@@ -305,6 +337,7 @@ static zend_function_entry php_driver_set_methods[] = {
         PHP_ME(Set, add, arginfo_one, ZEND_ACC_PUBLIC)
           PHP_ME(Set, has, arginfo_one, ZEND_ACC_PUBLIC)
             PHP_ME(Set, remove, arginfo_one, ZEND_ACC_PUBLIC)
+              PHP_ME(Set, fromArray, arginfo_from_array, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
   /* Countable */
   PHP_ME(Set, count, arginfo_count, ZEND_ACC_PUBLIC)
   /* Iterator */
@@ -365,13 +398,16 @@ php_driver_set_properties(
   return props;
 }
 
+static unsigned
+php_driver_set_hash_value(zval* obj );
+
 static int
 php_driver_set_compare(zval* obj1, zval* obj2 )
 {
 #if PHP_MAJOR_VERSION >= 8
   ZEND_COMPARE_OBJECTS_FALLBACK(obj1, obj2);
 #endif
-  php_driver_set_entry *curr, *temp;
+  php_driver_flat_entry* curr;
   php_driver_set* set1;
   php_driver_set* set2;
   php_driver_type* type1;
@@ -391,15 +427,17 @@ php_driver_set_compare(zval* obj1, zval* obj2 )
   if (result != 0)
     return result;
 
-  if (HASH_COUNT(set1->entries) != HASH_COUNT(set2->entries)) {
-    return HASH_COUNT(set1->entries) < HASH_COUNT(set2->entries) ? -1 : 1;
+  if (set1->entries.count != set2->entries.count) {
+    return set1->entries.count < set2->entries.count ? -1 : 1;
+  }
+
+  if (php_driver_set_hash_value(obj1 ) != php_driver_set_hash_value(obj2 )) {
+    return 1;
   }
 
-  HASH_ITER(hh, set1->entries, curr, temp)
+  PHP_DRIVER_FLAT_HASH_FOREACH(&set1->entries, curr)
   {
-    php_driver_set_entry* entry;
-    HASH_FIND_ZVAL(set2->entries, &curr->value, entry);
-    if (entry == NULL) {
+    if (php_driver_flat_hash_find_hash(&set2->entries, &curr->key, curr->hash) == NULL) {
       return 1;
     }
   }
@@ -411,19 +449,20 @@ static unsigned
 php_driver_set_hash_value(zval* obj )
 {
   unsigned hashv = 0;
-  php_driver_set_entry *curr, *temp;
+  php_driver_flat_entry* curr;
   php_driver_set* self = PHP_DRIVER_GET_SET(obj);
 
-  if (!self->dirty)
+  if (PHP_DRIVER_HASH_CACHED(self, 0))
     return self->hashv;
 
-  HASH_ITER(hh, self->entries, curr, temp)
+  /* Summing the cached entry hashes gives equal sets the same hash whatever
+   * order their values were added in */
+  PHP_DRIVER_FLAT_HASH_FOREACH(&self->entries, curr)
   {
-    hashv = php_driver_combine_hash(hashv, php_driver_value_hash(&curr->value ));
+    hashv += curr->hash;
   }
 
-  self->hashv = hashv;
-  self->dirty = 0;
+  PHP_DRIVER_HASH_STORE(self, hashv, 0, 0);
 
   return hashv;
 }
@@ -432,14 +471,8 @@ static void
 php_driver_set_free(zend_object* object )
 {
   php_driver_set* self = PHP5TO7_ZEND_OBJECT_GET(set, object);
-  php_driver_set_entry *curr, *temp;
 
-  HASH_ITER(hh, self->entries, curr, temp)
-  {
-    zval_ptr_dtor(&curr->value);
-    HASH_DEL(self->entries, curr);
-    efree(curr);
-  }
+  php_driver_flat_hash_destroy(&self->entries);
 
   PHP5TO7_ZVAL_MAYBE_DESTROY(self->type);
 
@@ -453,9 +486,10 @@ php_driver_set_new(zend_class_entry* ce )
   php_driver_set* self =
     PHP5TO7_ZEND_OBJECT_ECALLOC(set, ce);
 
-  self->entries = self->iter_curr = self->iter_temp = NULL;
-  self->iter_index                                  = 0;
-  self->dirty                                       = 1;
+  php_driver_flat_hash_init(&self->entries);
+  self->iter_pos   = 0;
+  self->iter_index = 0;
+  self->dirty      = 1;
   ZVAL_UNDEF(&self->type);
 
   PHP5TO7_ZEND_OBJECT_INIT(set, self, ce);
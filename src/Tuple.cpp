@@ -31,7 +31,7 @@ php_driver_tuple_set(php_driver_tuple *tuple, ulong index, zval *object )
 {
   PHP5TO7_ZEND_HASH_INDEX_UPDATE(&tuple->values, index, object, sizeof(zval *));
   Z_TRY_ADDREF_P(object);
-  tuple->dirty = 1;
+  PHP_DRIVER_VALUE_MUTATED(tuple);
 }
 
 static void
@@ -416,17 +416,23 @@ php_driver_tuple_hash_value(zval *obj )
 {
   zval *current;
   unsigned hashv = 0;
+  zend_bool nested = 0;
+  zend_ulong version = 0;
   php_driver_tuple *self = PHP_DRIVER_GET_TUPLE(obj);
 
-  if (!self->dirty) return self->hashv;
+  if (PHP_DRIVER_HASH_CACHED(self, php_driver_nested_hash_cached(&self->values, self->hash_version)))
+    return self->hashv;
 
   PHP5TO7_ZEND_HASH_FOREACH_VAL(&self->values, current) {
     hashv = php_driver_combine_hash(hashv,
                                        php_driver_value_hash(current ));
+    if (php_driver_value_is_nested(current)) {
+      nested = 1;
+      version += php_driver_value_version(current);
+    }
   } PHP5TO7_ZEND_HASH_FOREACH_END(&self->values);
 
-  self->hashv = hashv;
-  self->dirty = 0;
+  PHP_DRIVER_HASH_STORE(self, hashv, nested, version);
 
   return hashv;
 }
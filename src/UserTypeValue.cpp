@@ -34,7 +34,7 @@ php_driver_user_type_value_set(php_driver_user_type_value *user_type_value,
                            name, name_length + 1,
                            object, sizeof(zval *));
   Z_TRY_ADDREF_P(object);
-  user_type_value->dirty = 1;
+  PHP_DRIVER_VALUE_MUTATED(user_type_value);
 }
 
 static void
@@ -453,17 +453,23 @@ php_driver_user_type_value_hash_value(zval *obj )
 {
   zval *current;
   unsigned hashv = 0;
+  zend_bool nested = 0;
+  zend_ulong version = 0;
   php_driver_user_type_value *self = PHP_DRIVER_GET_USER_TYPE_VALUE(obj);
 
-  if (!self->dirty) return self->hashv;
+  if (PHP_DRIVER_HASH_CACHED(self, php_driver_nested_hash_cached(&self->values, self->hash_version)))
+    return self->hashv;
 
   PHP5TO7_ZEND_HASH_FOREACH_VAL(&self->values, current) {
     hashv = php_driver_combine_hash(hashv,
                                        php_driver_value_hash(current ));
+    if (php_driver_value_is_nested(current)) {
+      nested = 1;
+      version += php_driver_value_version(current);
+    }
   } PHP5TO7_ZEND_HASH_FOREACH_END(&self->values);
 
-  self->hashv = hashv;
-  self->dirty = 0;
+  PHP_DRIVER_HASH_STORE(self, hashv, nested, version);
 
   return hashv;
 }
@@ -195,3 +195,224 @@ it('Using Cassandra nested collections', function () use ($nestedCollections) {
         ->and($address->values()[2])
         ->toBe('85023');
 });
+
+it('Keeps insertion order of sets and maps across removals', function () {
+    $set = new Set(\Cassandra\Type::int());
+    $map = new Map(\Cassandra\Type::int(), \Cassandra\Type::text());
+
+    for ($i = 0; $i < 1000; $i++) {
+        $set->add($i);
+        $map->set($i, "value $i");
+    }
+
+    for ($i = 0; $i < 1000; $i += 2) {
+        $set->remove($i);
+        $map->remove($i);
+    }
+
+    for ($i = 1000; $i < 1100; $i++) {
+        $set->add($i);
+        $map->set($i, "value $i");
+    }
+
+    $expected = array_merge(range(1, 999, 2), range(1000, 1099));
+
+    expect($set)
+        ->toHaveCount(count($expected))
+        ->and($set->values())
+        ->toBe($expected)
+        ->and($set->has(998))
+        ->toBeFalse()
+        ->and($set->has(999))
+        ->toBeTrue()
+        ->and($map->keys())
+        ->toBe($expected)
+        ->and($map->get(1099))
+        ->toBe('value 1099')
+        ->and(iterator_to_array($map))
+        ->toBe(array_combine($expected, array_map(fn(int $i) => "value $i", $expected)));
+});
+
+it('Keeps iterating sets and maps that are compacted during a foreach', function () {
+    $set = new Set(\Cassandra\Type::int());
+    $map = new Map(\Cassandra\Type::int(), \Cassandra\Type::text());
+
+    // Filling the table makes the next addition reclaim the removed entries
+    for ($i = 0; $i < 8; $i++) {
+        $set->add($i);
+        $map->set($i, "value $i");
+    }
+
+    $visited = [];
+    foreach ($set as $value) {
+        $visited[] = $value;
+        if ($value === 3) {
+            for ($i = 0; $i <= 4; $i++) {
+                $set->remove($i);
+            }
+            $set->add(100);
+        }
+    }
+
+    expect($visited)->toBe([0, 1, 2, 3, 5, 6, 7, 100])
+        ->and($set->values())->toBe([5, 6, 7, 100]);
+
+    $visited = [];
+    foreach ($map as $key => $value) {
+        $visited[] = $key;
+        if ($key === 3) {
+            for ($i = 0; $i <= 4; $i++) {
+                $map->remove($i);
+            }
+            $map->set(100, 'value 100');
+        }
+    }
+
+    expect($visited)->toBe([0, 1, 2, 3, 5, 6, 7, 100])
+        ->and($map->keys())->toBe([5, 6, 7, 100]);
+});
+
+it('Builds collections from arrays', function () {
+    $set = Set::fromArray(\Cassandra\Type::text(), ['a', 'b', 'a', 'c']);
+    $collection = Collection::fromArray('int', ['x' => 1, 'y' => 2, 'z' => 3]);
+    $map = Map::fromArrays(\Cassandra\Type::text(), \Cassandra\Type::int(), ['a', 'b'], [1, 2]);
+    $assoc = Map::fromAssoc(\Cassandra\Type::text(), \Cassandra\Type::int(), ['a' => 1, '2' => 2]);
+
+    expect($set->values())
+        ->toBe(['a', 'b', 'c'])
+        ->and($set->type())
+        ->toEqual(\Cassandra\Type::set(\Cassandra\Type::text()))
+        ->and($collection->values())
+        ->toBe([1, 2, 3])
+        ->and($map->keys())
+        ->toBe(['a', 'b'])
+        ->and($map->values())
+        ->toBe([1, 2])
+        ->and($assoc->keys())
+        ->toBe(['a', '2'])
+        ->and($assoc->get('2'))
+        ->toBe(2);
+});
+
+it('Rejects arrays with invalid elements', function () {
+    expect(fn() => Set::fromArray(\Cassandra\Type::int(), [1, 'two']))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class)
+        ->and(fn() => Collection::fromArray(\Cassandra\Type::text(), ['one', null]))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class, 'Invalid value: null is not supported inside collections')
+        ->and(fn() => Map::fromArrays(\Cassandra\Type::text(), \Cassandra\Type::int(), ['a', 'b'], [1]))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class)
+        ->and(fn() => Map::fromAssoc(\Cassandra\Type::int(), \Cassandra\Type::int(), ['a' => 1]))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class);
+});
+
+it('Binds PHP arrays to collection parameters of prepared statements', function () use ($collections) {
+    $session = scyllaDbConnection($collections);
+
+    $insert = $session->prepare('INSERT INTO user (id, logins, locations, ip_addresses) VALUES (?, ?, ?, ?)');
+    $session->execute($insert, [
+        'arguments' => [
+            1,
+            [1410430148000, 1410516540000],
+            [1410430148000 => 37.397357],
+            ['200.199.198.197', '192.168.1.15', '192.168.1.15'],
+        ],
+    ]);
+
+    $row = $session->execute('SELECT * FROM user WHERE id = 1')->first();
+
+    expect($row['logins']->count())
+        ->toBe(2)
+        ->and($row['logins']->get(1)->time())
+        ->toBe(1410516540)
+        ->and($row['locations']->values())
+        ->toBe([37.397357])
+        ->and($row['ip_addresses'])
+        ->toHaveCount(2);
+
+    expect(fn() => $session->execute($insert, ['arguments' => [2, [null], [], []]]))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class);
+});
+
+it('Hashes and compares nested values consistently', function () {
+    $first = Set::fromArray(\Cassandra\Type::int(), [1, 2, 3]);
+    $second = Set::fromArray(\Cassandra\Type::int(), [3, 2, 1]);
+
+    $sets = new Set($first->type());
+    $sets->add($first);
+    $sets->add($second);
+
+    $listType = \Cassandra\Type::collection(\Cassandra\Type::int());
+    $tupleType = \Cassandra\Type::tuple($listType);
+
+    $list = Collection::fromArray(\Cassandra\Type::int(), [1, 2]);
+    $tuple = $tupleType->create($list);
+
+    $other = Collection::fromArray(\Cassandra\Type::int(), [1]);
+    $otherTuple = $tupleType->create($other);
+
+    $tuples = new Set($tupleType);
+    $tuples->add($tuple);
+
+    // Hashes the tuple before its list changes
+    expect($tuples->has($otherTuple))->toBeFalse();
+
+    $other->add(2);
+
+    expect($first == $second)
+        ->toBeTrue()
+        ->and($sets)
+        ->toHaveCount(1)
+        ->and($tuples->has($otherTuple))
+        ->toBeTrue();
+});
+
+it('Shares the types of nested collections across results', function () use ($nestedCollections) {
+    $session = scyllaDbConnection($nestedCollections);
+
+    $session->execute(
+        "INSERT INTO users (id, name, addresses) VALUES (?, ?, ?)",
+        [
+            'arguments' => [
+                new Uuid('14b1d5a4-2c49-4a3e-9df4-6c8a3c5e7a10'),
+                'Interned Types',
+                Map::fromAssoc(
+                    \Cassandra\Type::text(),
+                    \Cassandra\Type::map(\Cassandra\Type::text(), \Cassandra\Type::text()),
+                    ['home' => Map::fromAssoc(\Cassandra\Type::text(), \Cassandra\Type::text(), ['city' => 'Phoenix'])]
+                ),
+            ],
+        ]
+    );
+
+    $query = "SELECT addresses FROM users WHERE id = 14b1d5a4-2c49-4a3e-9df4-6c8a3c5e7a10";
+    $first = $session->execute($query)->first()['addresses'];
+    $second = $session->execute($query)->first()['addresses'];
+
+    expect($first->type())
+        ->toBe($second->type())
+        ->and($first->get('home')->type())
+        ->toBe($second->get('home')->type());
+});
+
+it('Notices changes of values nested more than one level deep', function () {
+    $innerType = \Cassandra\Type::collection(\Cassandra\Type::int());
+
+    $stored = new Collection($innerType);
+    $stored->add(Collection::fromArray(\Cassandra\Type::int(), [1, 2]));
+    $tupleType = \Cassandra\Type::tuple($stored->type());
+
+    $tuples = new Set($tupleType);
+    $tuples->add($tupleType->create($stored));
+
+    $inner = Collection::fromArray(\Cassandra\Type::int(), [1]);
+    $outer = new Collection($innerType);
+    $outer->add($inner);
+    $probe = $tupleType->create($outer);
+
+    // Hashes the probe before the list two levels down changes
+    expect($tuples->has($probe))->toBeFalse();
+
+    $inner->add(2);
+
+    expect($tuples->has($probe))->toBeTrue();
+});
@@ -23,6 +23,9 @@ beforeAll(function () use($keyspace, $table) {
             name text,
             addresses frozen<addresses>
         );
+        CREATE TYPE badge (label text);
+        CREATE TABLE badges (id int PRIMARY KEY, badge frozen<badge>);
+        INSERT INTO badges (id, badge) VALUES (1, {label: 'gold'});
     CQL
     );
 });
@@ -138,3 +141,16 @@ it('Using Cassandra user defined types from schema metadata', function () use($k
         ->and($workAddress['zip'])
         ->toBe(10024);
 });
+
+it('Decodes renamed user type fields with a reused prepared statement', function () use($keyspace) {
+    $session = scyllaDbConnection($keyspace);
+    $select = $session->prepare("SELECT badge FROM badges WHERE id = 1");
+
+    $before = $session->execute($select)->first()['badge']->values();
+
+    $session->execute("ALTER TYPE badge RENAME label TO title");
+    $after = $session->execute($select)->first()['badge']->values();
+
+    expect($before)->toBe(['label' => 'gold'])
+        ->and($after)->toBe(['title' => 'gold']);
+});
@@ -0,0 +1,160 @@
+<?php
+
+declare(strict_types=1);
+
+namespace Cassandra\Tests\Feature\Results;
+
+use Cassandra\Blob;
+use Cassandra\Uuid;
+use Cassandra\Bigint;
+use Cassandra\Tinyint;
+use Cassandra\Smallint;
+use Cassandra\ExecutionOptions;
+
+$keyspace = 'native_values';
+$table = 'native_values';
+
+beforeAll(function () use ($keyspace, $table) {
+    migrateKeyspace(<<<CQL
+    CREATE KEYSPACE $keyspace WITH replication = {
+        'class': 'SimpleStrategy',
+        'replication_factor': 1
+    };
+    USE $keyspace;
+    CREATE TABLE $table (
+        id int PRIMARY KEY,
+        data blob,
+        uid uuid,
+        big bigint,
+        small smallint,
+        tiny tinyint
+    );
+    INSERT INTO $table (id, data, uid, big, small, tiny) VALUES (
+        1,
+        0x6361737361,
+        56357d2b-4586-433c-ad24-afa9918bc415,
+        9223372036854775807,
+        -32768,
+        127
+    );
+    CQL
+    );
+});
+
+afterAll(function () use ($keyspace) {
+    dropKeyspace($keyspace);
+});
+
+it('Decodes blob, uuid and bigint columns into plain PHP values', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $query = "SELECT data, uid, big FROM $table WHERE id = 1";
+
+    $row = $session->execute($query, ['native_scalars' => true])->first();
+
+    expect($row['data'])
+        ->toBe('cassa')
+        ->and($row['uid'])
+        ->toBe('56357d2b-4586-433c-ad24-afa9918bc415')
+        ->and($row['big'])
+        ->toBe(PHP_INT_MAX);
+
+    $row = $session->execute($query)->first();
+
+    expect($row['data'])
+        ->toBeInstanceOf(Blob::class)
+        ->and($row['uid'])
+        ->toBeInstanceOf(Uuid::class)
+        ->and($row['big'])
+        ->toBeInstanceOf(Bigint::class);
+});
+
+it('Keeps native_scalars when native_integers is disabled', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $options = ['native_scalars' => true, 'native_integers' => false];
+
+    $row = $session->execute("SELECT data, uid, big FROM $table WHERE id = 1", $options)->first();
+
+    expect((new ExecutionOptions($options))->nativeScalars)
+        ->toBeTrue()
+        ->and($row['big'])
+        ->toBe(PHP_INT_MAX)
+        ->and($row['data'])
+        ->toBe('cassa');
+});
+
+it('Decodes smallint, tinyint and bigint columns into integers', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $query = "SELECT data, big, small, tiny FROM $table WHERE id = 1";
+
+    $row = $session->execute($query, ['native_integers' => true])->first();
+
+    expect($row['big'])
+        ->toBe(PHP_INT_MAX)
+        ->and($row['small'])
+        ->toBe(-32768)
+        ->and($row['tiny'])
+        ->toBe(127)
+        ->and($row['data'])
+        ->toBeInstanceOf(Blob::class);
+
+    $row = $session->execute($query, ['native_integers' => false])->first();
+
+    expect($row['big'])
+        ->toBeInstanceOf(Bigint::class)
+        ->and($row['small'])
+        ->toBeInstanceOf(Smallint::class)
+        ->and($row['tiny'])
+        ->toBeInstanceOf(Tinyint::class);
+});
+
+it('Combines native_integers with native_scalars', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $query = "SELECT data, big, small, tiny FROM $table WHERE id = 1";
+
+    $row = $session->execute($query, ['native_integers' => true, 'native_scalars' => true])->first();
+
+    expect($row['data'])
+        ->toBe('cassa')
+        ->and($row['big'])
+        ->toBe(PHP_INT_MAX)
+        ->and($row['small'])
+        ->toBe(-32768);
+
+    $row = $session->execute($query, ['native_integers' => true, 'native_scalars' => false])->first();
+
+    expect($row['data'])
+        ->toBeInstanceOf(Blob::class)
+        ->and($row['big'])
+        ->toBe(PHP_INT_MAX)
+        ->and($row['tiny'])
+        ->toBe(127);
+});
+
+it('Keeps decoded blobs readable once their rows are released', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $large = str_repeat('scylla', 2048);
+
+    $session->execute("INSERT INTO $table (id, data) VALUES (2, ?)", ['arguments' => [new Blob($large)]]);
+
+    $rows = $session->execute("SELECT id, data FROM $table WHERE id IN (1, 2)");
+    $blobs = [];
+    foreach ($rows as $row) {
+        $blobs[$row['id']] = $row['data'];
+    }
+    unset($rows, $row);
+    gc_collect_cycles();
+
+    expect($blobs[1]->toBinaryString())
+        ->toBe('cassa')
+        ->and($blobs[1]->bytes())
+        ->toBe('0x6361737361')
+        ->and($blobs[2]->toBinaryString())
+        ->toBe($large)
+        ->and($blobs[2]->bytes())
+        ->toBe('0x' . bin2hex($large));
+
+    $blobs[2]->__construct('replaced');
+    expect($blobs[2]->toBinaryString())->toBe('replaced');
+
+    $session->execute("DELETE FROM $table WHERE id = 2");
+});
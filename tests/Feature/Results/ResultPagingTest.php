@@ -128,3 +128,80 @@ it('Use paging state token to get next result', function () use ($table, $keyspa
 
     expect($resultedRows)->toEqual($expectedResult);
 });
+
+it('Fetching columns of a page', function () use ($table, $keyspace, $dataProvider) {
+    $session = scyllaDbConnection($keyspace);
+
+    $rows = $session->execute("SELECT key, value FROM $table");
+
+    $keys = $rows->fetchColumn('key');
+    $values = $rows->fetchColumn(1);
+
+    expect(array_combine($keys, $values))->toEqual($dataProvider);
+    expect($rows->toColumns(['value']))->toBe(['value' => $values]);
+    expect($rows->toColumns())->toBe(['key' => $keys, 'value' => $values]);
+    expect(fn() => $rows->fetchColumn('missing'))->toThrow(\Cassandra\Exception\InvalidArgumentException::class);
+});
+
+it('Accessing rows of a page lazily', function () use ($table, $keyspace, $dataProvider) {
+    $session = scyllaDbConnection($keyspace);
+
+    $expected = [];
+    foreach ($session->execute("SELECT key, value FROM $table") as $row) {
+        $expected[] = $row;
+    }
+
+    $rows = $session->execute("SELECT key, value FROM $table");
+
+    expect($rows->count())->toBe(count($dataProvider))
+        ->and($rows->isLastPage())->toBeTrue()
+        ->and($rows->first())->toBe($expected[0]);
+
+    $iterated = [];
+    foreach ($rows as $index => $row) {
+        $iterated[$index] = $row;
+    }
+
+    expect($iterated)->toBe($expected);
+
+    $rows = $session->execute("SELECT key, value FROM $table");
+
+    expect($rows[3])->toBe($expected[3])
+        ->and($rows[3])->toBe($expected[3])
+        ->and($rows[7])->toBe($expected[7])
+        ->and(isset($rows[12]))->toBeTrue()
+        ->and($rows[1])->toBe($expected[1])
+        ->and(isset($rows[13]))->toBeFalse()
+        ->and($rows[12])->toBe($expected[12])
+        ->and($rows->first())->toBe($expected[0]);
+
+    $reversed = [];
+    for ($i = $rows->count() - 1; $i >= 0; $i--) {
+        $reversed[] = $rows[$i];
+    }
+
+    expect($reversed)->toBe(array_reverse($expected));
+});
+
+it('Streaming every page of a result', function () use ($table, $keyspace, $dataProvider) {
+    $session = scyllaDbConnection($keyspace);
+
+    $rows = $session->executeStream("SELECT * FROM $table", ['page_size' => 5]);
+
+    $resultedRows = [];
+    $keys = [];
+    foreach ($rows as $index => $row) {
+        $keys[] = $index;
+        $resultedRows[$row['key']] = $row['value'];
+    }
+
+    expect($resultedRows)->toEqual($dataProvider);
+    expect($keys)->toBe(range(0, count($dataProvider) - 1));
+    expect($rows->isLastPage())->toBeTrue();
+
+    $rows = $session->executeStream("SELECT * FROM $table", ['page_size' => 5]);
+
+    expect($rows->count())->toBe(5)
+        ->and(fn() => $rows[0])->toThrow(\Cassandra\Exception\LogicException::class)
+        ->and(fn() => isset($rows[0]))->toThrow(\Cassandra\Exception\LogicException::class);
+});
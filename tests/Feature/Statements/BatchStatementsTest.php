@@ -6,6 +6,8 @@ namespace Cassandra\Tests\Feature\Statements;
 
 use Cassandra;
 use Cassandra\BatchStatement;
+use Cassandra\Bigint;
+use Cassandra\Type;
 use Cassandra\Uuid;
 
 /**
@@ -42,6 +44,16 @@ beforeAll(function () use($keyspace, $table) {
         song_id uuid,
         PRIMARY KEY (id, title, album, artist)
     );
+    CREATE TABLE grouped_counters (
+        id bigint,
+        seq int,
+        PRIMARY KEY (id, seq)
+    );
+    CREATE TABLE grouped_tuples (
+        key frozen<tuple<int, text>>,
+        seq int,
+        PRIMARY KEY (key, seq)
+    );
     CQL
     );
 });
@@ -88,4 +100,121 @@ test('Batch statements can contain simple and prepared statements', function ()
         $fullValue = sprintf("%s: %s / %s", $row['artist'], $row['title'], $row['album']);
         expect($fullValue)->toBe($expectations[$key]);
     }
-});
\ No newline at end of file
+});
+
+test('Batch statements bind entries when added and can be executed repeatedly', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+
+    $prepared = $session->prepare("INSERT INTO $table (id, song_id, artist, title, album) VALUES (?, ?, ?, ?, ?)");
+    $batch    = new BatchStatement(Cassandra::BATCH_UNLOGGED);
+    $id       = new Uuid('9b3cf3f6-1c9a-4a4e-8d0e-2b3e4f5a6b7c');
+
+    expect($batch->add($prepared, [$id, new Uuid(), 'Artist', 'First', 'Album']))->toBe($batch);
+    $batch->add($prepared, [$id, new Uuid(), 'Artist', 'Second', 'Album']);
+    expect($batch)->toHaveCount(2);
+
+    $session->execute($batch);
+    $future = $session->executeAsync($batch);
+
+    $batch->add($prepared, [$id, new Uuid(), 'Artist', 'Third', 'Album']);
+    expect(count($batch))->toBe(3);
+
+    $future->get();
+    $session->execute($batch);
+
+    $result = $session->execute("SELECT * FROM $table WHERE id = ?", ['arguments' => [$id]]);
+    expect($result->count())->toBe(3);
+
+    expect(fn() => $batch->add($prepared, [$id]))->toThrow(\Cassandra\Exception::class);
+    expect($batch)->toHaveCount(3);
+});
+
+test('Rows can be executed in batches grouped by partition', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+
+    $insert = $session->prepare("INSERT INTO $table (id, song_id, artist, title, album) VALUES (:id, :song_id, :artist, :title, :album)");
+    $ids = [
+        '0a9d6f0e-7a15-4bd6-9d48-1a6c4e5ab001',
+        '0a9d6f0e-7a15-4bd6-9d48-1a6c4e5ab002',
+        '0a9d6f0e-7a15-4bd6-9d48-1a6c4e5ab003',
+    ];
+
+    $rows = [];
+    for ($i = 0; $i < 30; $i++) {
+        $rows["song$i"] = [
+            'id' => new Uuid($ids[$i % 3]),
+            'song_id' => new Uuid(),
+            'artist' => 'Artist',
+            'title' => "Title $i",
+            'album' => 'Album',
+        ];
+    }
+    $rows['missing'] = ['song_id' => new Uuid(), 'artist' => 'Artist', 'title' => 'Missing', 'album' => 'Album'];
+
+    $result = $session->executeGrouped($insert, $rows, ['id'], 4, 2);
+
+    expect($result['success'])->toBe(30)
+        ->and($result['failure'])->toBe(1)
+        ->and($result['batches'])->toBe(9)
+        ->and($result['errors'])->toHaveKey('missing');
+
+    $table = $session->schema()->keyspace($keyspace)->table($table);
+    $again = $session->executeGrouped($insert, array_slice($rows, 0, 30), $table, 100);
+    expect($again['batches'])->toBe(3);
+
+    foreach ($ids as $id) {
+        $count = $session->execute("SELECT * FROM playlists WHERE id = ?", ['arguments' => [new Uuid($id)]])->count();
+        expect($count)->toBe(10);
+    }
+});
+
+test('Rows are grouped by partition key value regardless of the PHP type given', function () use ($keyspace) {
+    $session = scyllaDbConnection($keyspace);
+
+    $insert = $session->prepare("INSERT INTO grouped_counters (id, seq) VALUES (?, ?)");
+    $rows = [[1, 0], [new Bigint(1), 1], [new Bigint('1'), 2], [2, 3]];
+
+    $result = $session->executeGrouped($insert, $rows, [0]);
+
+    expect($result['success'])->toBe(4)
+        ->and($result['batches'])->toBe(2);
+
+    $tupleType = Type::tuple(Type::int(), Type::text());
+    $insert = $session->prepare("INSERT INTO grouped_tuples (key, seq) VALUES (:key, :seq)");
+    $rows = [
+        ['key' => $tupleType->create(1, 'a'), 'seq' => 0],
+        ['key' => $tupleType->create(1, 'a'), 'seq' => 1],
+        ['key' => $tupleType->create(2, 'b'), 'seq' => 2],
+    ];
+
+    $result = $session->executeGrouped($insert, $rows, ['key']);
+
+    expect($result['success'])->toBe(3)
+        ->and($result['batches'])->toBe(2);
+
+    $count = $session->execute("SELECT * FROM grouped_tuples WHERE key = ?", [
+        'arguments' => [$tupleType->create(1, 'a')],
+    ])->count();
+    expect($count)->toBe(2);
+});
+
+test('Batch statements can be extended while discarded requests are pending', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $id = new Uuid('0a9d6f0e-7a15-4bd6-9d48-1a6c4e5ab0ff');
+
+    $insert = $session->prepare("INSERT INTO $table (id, song_id, artist, title, album) VALUES (?, ?, ?, ?, ?)");
+    $batch = new BatchStatement(Cassandra::BATCH_UNLOGGED);
+
+    // Each discarded request keeps the driver batch it was sent with
+    for ($i = 0; $i < 20; $i++) {
+        $batch->add($insert, [$id, new Uuid(), 'Artist', "Title $i", 'Album']);
+        $session->executeAsync($batch, ['consistency' => $i % 2 ? Cassandra::CONSISTENCY_ONE : Cassandra::CONSISTENCY_QUORUM]);
+    }
+
+    for ($wait = 0; $wait < 500 && $session->metrics()['requests']['in_flight'] > 0; $wait++) {
+        usleep(10000);
+    }
+
+    $count = $session->execute("SELECT * FROM $table WHERE id = ?", ['arguments' => [$id]])->count();
+    expect($count)->toBe(20);
+});
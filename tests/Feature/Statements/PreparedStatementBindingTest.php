@@ -0,0 +1,231 @@
+<?php
+declare(strict_types=1);
+
+namespace Cassandra\Tests\Feature\Statements;
+
+use Cassandra\Bigint;
+use Cassandra\Exception\InvalidArgumentException;
+use Cassandra\Exception\RangeException;
+use Cassandra\Exception\TimeoutException;
+use Cassandra\PreparedStatement;
+use Cassandra\Uuid;
+
+$keyspace = 'prepared_statement_binding';
+$table = 'typed_values';
+
+beforeAll(function () use ($keyspace, $table) {
+    migrateKeyspace(<<<CQL
+    CREATE KEYSPACE $keyspace WITH replication = {
+        'class': 'SimpleStrategy',
+        'replication_factor': 1
+      };
+      USE $keyspace;
+      CREATE TABLE $table (
+        id uuid PRIMARY KEY,
+        big bigint,
+        small smallint,
+        tiny tinyint,
+        ts timestamp,
+        ratio float,
+        address inet
+      );
+      CREATE TABLE clustered_values (k int, c int, PRIMARY KEY (k, c));
+      INSERT INTO clustered_values (k, c) VALUES (1, 0);
+      INSERT INTO clustered_values (k, c) VALUES (1, 1);
+      INSERT INTO clustered_values (k, c) VALUES (1, 2);
+      INSERT INTO clustered_values (k, c) VALUES (1, 3);
+    CQL
+    );
+});
+
+afterAll(function () use ($keyspace) {
+    dropKeyspace($keyspace);
+});
+
+test('Prepared statements convert PHP scalars to the parameter types', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $id = '756716f7-2e54-4715-9f00-91dcbea6cf50';
+
+    $insert = $session->prepare(
+        "INSERT INTO $table (id, big, small, tiny, ts, ratio, address) VALUES (?, ?, ?, ?, ?, ?, ?)"
+    );
+    $session->execute($insert, [
+        'arguments' => [$id, PHP_INT_MAX, 1024, -12, 1700000000000, 1.5, '127.0.0.1'],
+    ]);
+
+    $select = $session->prepare("SELECT * FROM $table WHERE id = :id");
+    $row = $session->execute($select, ['arguments' => ['id' => $id]])->first();
+
+    expect($row['id'])->toEqual(new Uuid($id))
+        ->and($row['big'])->toEqual(new Bigint(PHP_INT_MAX))
+        ->and($row['small']->value())->toBe(1024)
+        ->and($row['tiny']->value())->toBe(-12)
+        ->and($row['ts']->time())->toBe(1700000000)
+        ->and($row['ratio']->value())->toBe(1.5)
+        ->and((string)$row['address'])->toBe('127.0.0.1');
+});
+
+test('Prepared statements reject integers outside of the parameter range', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $insert = $session->prepare("INSERT INTO $table (id, small) VALUES (?, ?)");
+
+    $session->execute($insert, ['arguments' => [(string)new Uuid(), 1 << 20]]);
+})->throws(RangeException::class);
+
+test('Prepared statements can be executed concurrently over many argument rows', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $insert = $session->prepare("INSERT INTO $table (id, big) VALUES (?, ?)");
+
+    $rows = (function () {
+        for ($i = 0; $i < 50; $i++) {
+            yield "row$i" => [(string)new Uuid(), $i];
+        }
+        yield 'invalid' => ['not-a-uuid', 0];
+    })();
+
+    $result = $session->executeConcurrent($insert, $rows, 8);
+
+    expect($result['success'])->toBe(50)
+        ->and($result['failure'])->toBe(1)
+        ->and($result['errors'])->toHaveKey('invalid');
+});
+
+test('Concurrent executions are bounded by a single timeout', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $insert = $session->prepare("INSERT INTO $table (id, big) VALUES (?, ?)");
+
+    $rows = [];
+    for ($i = 0; $i < 200; $i++) {
+        $rows[] = [(string)new Uuid(), $i];
+    }
+
+    expect(fn() => $session->executeConcurrent($insert, $rows, 4, ['timeout' => 0.000001]))
+        ->toThrow(TimeoutException::class);
+
+    // Requests abandoned by the timeout don't affect later calls
+    expect($session->executeConcurrent($insert, array_slice($rows, 0, 10), 4)['success'])->toBe(10);
+});
+
+test('Bound statements can be rebound and executed repeatedly', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $id = 'a2ec8ed5-3f4a-4ef5-9a0b-1ed2a5cf5b2e';
+
+    $insert = $session->prepare("INSERT INTO $table (id, big) VALUES (?, ?)")->bind([$id, 1]);
+    $select = $session->prepare("SELECT big FROM $table WHERE id = ?")->bind([$id]);
+
+    $session->execute($insert);
+    expect($session->execute($select)->first()['big'])->toEqual(new Bigint(1));
+
+    $session->execute($insert->bind([$id, 2]));
+    expect($session->execute($select)->first()['big'])->toEqual(new Bigint(2));
+});
+
+test('Bound statements keep omitted parameters while paged rows are held', function () use ($keyspace) {
+    $session = scyllaDbConnection($keyspace);
+
+    $select = $session->prepare("SELECT c FROM clustered_values WHERE k = :k AND c >= :c")
+        ->bind(['k' => 1, 'c' => 0]);
+
+    // The paged rows keep a reference to the driver statement
+    $rows = $session->execute($select, ['page_size' => 1]);
+
+    $values = [];
+    foreach ($session->execute($select->bind(['c' => 2])) as $row) {
+        $values[] = $row['c'];
+    }
+
+    expect($values)->toBe([2, 3])
+        ->and($rows->first()['c'])->toBe(0)
+        ->and($rows->nextPage()->first()['c'])->toBe(1);
+});
+
+test('Bound statements keep their arguments when rebinding fails', function () use ($keyspace) {
+    $session = scyllaDbConnection($keyspace);
+
+    $select = $session->prepare("SELECT c FROM clustered_values WHERE k = ? AND c >= ?")->bind([1, 1]);
+
+    // The partition key is bound before the out of range value fails
+    expect(fn() => $select->bind([2, 1 << 40]))->toThrow(RangeException::class)
+        ->and($session->execute($select)->first()['c'])->toBe(1);
+});
+
+test('Bound statements apply the execution options not given when binding', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $id = '5b0c4e1a-8d0e-4c47-9d2e-6f1e0a3b7c21';
+
+    $insert = $session->prepare("INSERT INTO $table (id, big) VALUES (?, ?)")->bind([$id, 1]);
+    $session->execute($insert, ['timestamp' => 1000]);
+
+    $select = $session->prepare("SELECT WRITETIME(big) AS written FROM $table WHERE id = ?")->bind([$id]);
+    expect($session->execute($select)->first()['written'])->toEqual(new Bigint(1000));
+
+    // The timestamp given when binding wins over the execution one
+    $insert = $session->prepare("INSERT INTO $table (id, big) VALUES (?, ?)")
+        ->bind([$id, 2], ['timestamp' => 2000]);
+    $session->execute($insert, ['timestamp' => 3000]);
+    expect($session->execute($select)->first()['written'])->toEqual(new Bigint(2000));
+
+    expect(fn() => $session->execute($insert, ['arguments' => [$id, 3]]))
+        ->toThrow(InvalidArgumentException::class);
+});
+
+test('Bound statements can be rebound while discarded requests are pending', function () use ($keyspace) {
+    $session = scyllaDbConnection($keyspace);
+
+    $insert = $session->prepare("INSERT INTO clustered_values (k, c) VALUES (?, ?)")->bind([2, 0]);
+
+    // Each discarded request keeps the driver statement it was sent with
+    for ($c = 0; $c < 50; $c++) {
+        $session->executeAsync($insert->bind([2, $c]));
+    }
+
+    for ($wait = 0; $wait < 500 && $session->metrics()['requests']['in_flight'] > 0; $wait++) {
+        usleep(10000);
+    }
+
+    $values = [];
+    foreach ($session->execute("SELECT c FROM clustered_values WHERE k = 2") as $row) {
+        $values[] = $row['c'];
+    }
+
+    expect($values)->toBe(range(0, 49));
+});
+
+test('Persistent sessions reuse cached prepared statements', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $id = '0d6b1d4e-6a6f-4f0e-9a5e-3f5f8c1b2a77';
+    $cql = "INSERT INTO $table (id, small) VALUES (?, ?)";
+
+    expect(ini_get('cassandra.prepared_cache_size'))->toBe('1000');
+
+    $first = $session->prepare($cql);
+    $second = $session->prepare($cql);
+    $session->execute($second, ['arguments' => [$id, 7]]);
+
+    $select = $session->prepare("SELECT small FROM $table WHERE id = ?");
+    $row = $session->execute($select, ['arguments' => [$id]])->first();
+
+    expect($first)->not->toBe($second)
+        ->and($row['small']->value())->toBe(7);
+});
+
+test('Statements are prepared together and reused by prepareAsync()', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+
+    $statements = $session->prepareAll([
+        'insert' => "INSERT INTO $table (id, tiny) VALUES (?, ?)",
+        'select' => "SELECT tiny FROM $table WHERE id = ?",
+    ]);
+
+    expect(array_keys($statements))->toBe(['insert', 'select'])
+        ->and($statements['insert'])->toBeInstanceOf(PreparedStatement::class);
+
+    $id = '5b0c8a4e-2f7d-4c37-9a61-7d2f1b0e9c33';
+    $session->execute($statements['insert'], ['arguments' => [$id, 3]]);
+
+    $select = $session->prepareAsync("SELECT tiny FROM $table WHERE id = ?")->get();
+    $row = $session->execute($select, ['arguments' => [$id]])->first();
+
+    expect($select)->toBeInstanceOf(PreparedStatement::class)
+        ->and($row['tiny']->value())->toBe(3);
+});
@@ -175,3 +175,119 @@ test('Simple statements also supports ":name" arguments', function () use ($keys
     $fullValue = sprintf("%s: %s / %s", $row['artist'], $row['title'], $row['album']);
     expect($fullValue)->toBe('Joséphine Baker: La Petite Tonkinoise / Bye Bye Blackbird');
 });
+
+test('Waiting on many asynchronous statements at once', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+
+    $futures = [
+        'all' => $session->executeAsync("SELECT * FROM $table"),
+        'none' => $session->executeAsync("SELECT * FROM $table WHERE id = ?", [
+            'arguments' => [new Uuid('00000000-0000-0000-0000-000000000000')]
+        ]),
+        'invalid' => $session->executeAsync("SELECT * FROM missing_table"),
+    ];
+
+    $settled = \Cassandra\Futures::settled($futures, 10);
+    expect($settled)->toHaveKeys(['all', 'none', 'invalid']);
+    expect($settled['none'])->toBeInstanceOf(\Cassandra\Rows::class);
+    expect($settled['invalid'])->toBeInstanceOf(\Cassandra\Exception::class);
+
+    $results = \Cassandra\Futures::all(['none' => $futures['none'], 'all' => $futures['all']], 10);
+    expect(array_keys($results))->toBe(['none', 'all']);
+
+    expect(\Cassandra\Futures::any([$futures['invalid'], $futures['none']], 10))->toBeInstanceOf(\Cassandra\Rows::class);
+    expect(fn() => \Cassandra\Futures::all($futures, 10))->toThrow(\Cassandra\Exception::class);
+
+    $pages = $session->execute("SELECT * FROM $table", ['page_size' => 1]);
+    $resolved = \Cassandra\Futures::all([
+        $session->prepareAsync("SELECT * FROM $table"),
+        $pages->nextPageAsync(),
+    ]);
+    expect($resolved)->toHaveCount(2)
+        ->and($resolved[0])->toBeInstanceOf(\Cassandra\PreparedStatement::class);
+
+    $future = $session->executeAsync("SELECT * FROM $table");
+    $resolved = \Cassandra\Futures::all(['a' => $future, 'b' => $future], 10);
+    expect($resolved['a'])->toBeInstanceOf(\Cassandra\Rows::class)
+        ->and($resolved['b'])->toBeInstanceOf(\Cassandra\Rows::class);
+});
+
+test('Statements select execution profiles by name', function () use ($keyspace, $table) {
+    $hosts = env('SCYLLADB_HOSTS', '127.0.0.1');
+
+    $session = \Cassandra::cluster()
+        ->withContactPoints(...explode(',', $hosts))
+        ->withPort((int)env('SCYLLADB_PORT', 9042))
+        ->withCredentials(env('SCYLLADB_USERNAME', 'cassandra'), env('SCYLLADB_PASSWORD', 'cassandra'))
+        ->withPersistentSessions(false)
+        ->withExecutionProfile('one', ['consistency' => \Cassandra::CONSISTENCY_ONE, 'timeout' => 5])
+        ->build()
+        ->connect($keyspace);
+
+    $result = $session->execute("SELECT * FROM $table", ['execution_profile' => 'one']);
+    expect($result)->toBeInstanceOf(\Cassandra\Rows::class);
+
+    $options = new \Cassandra\ExecutionOptions(['execution_profile' => 'one']);
+    expect($options->executionProfile)->toBe('one');
+    expect($session->execute("SELECT * FROM $table", $options))->toBeInstanceOf(\Cassandra\Rows::class);
+
+    expect(fn() => \Cassandra::cluster()->withExecutionProfile('paged', ['page_size' => 10]))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class);
+});
+
+test('Persistent sessions prepare warm-up statements when they connect', function () use ($keyspace, $table) {
+    $hosts = env('SCYLLADB_HOSTS', '127.0.0.1');
+    $session = \Cassandra::cluster()
+        ->withContactPoints(...explode(',', $hosts))
+        ->withPort((int)env('SCYLLADB_PORT', 9042))
+        ->withCredentials(env('SCYLLADB_USERNAME', 'cassandra'), env('SCYLLADB_PASSWORD', 'cassandra'))
+        ->withPersistentSessions(true)
+        ->withWarmup(["SELECT * FROM $keyspace.$table", "SELECT * FROM $keyspace.missing_table"])
+        ->build()
+        ->connect($keyspace);
+
+    $status = $session->warmupStatus();
+
+    expect($status['complete'])->toBeTrue()
+        ->and($status['statements'])->toBe(2)
+        ->and($status['prepared'])->toBe(1)
+        ->and($status['failed'])->toBe(1);
+
+    expect(fn() => \Cassandra::cluster()->withWarmup([42]))
+        ->toThrow(\Cassandra\Exception\InvalidArgumentException::class);
+});
+
+test('Session metrics can be flattened', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $session->executeAsync("SELECT * FROM $table")->get();
+
+    $metrics = $session->metrics();
+    $flat = $session->metrics(true);
+
+    expect($metrics)->toHaveKeys(['stats', 'requests', 'errors', 'speculative_executions', 'prepared_cache'])
+        ->and($flat['requests_p99'])->toBe($metrics['requests']['p99'])
+        ->and($flat['requests_in_flight'])->toBeGreaterThanOrEqual(0)
+        ->and($flat)->toHaveKeys(['speculative_executions_count', 'prepared_cache_hits']);
+});
+
+test('Session metrics count the requests of each session', function () use ($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $other = scyllaDbConnection($keyspace);
+
+    $futures = [];
+    for ($i = 0; $i < 20; $i++) {
+        $futures[] = $session->executeAsync("SELECT * FROM $table");
+    }
+
+    expect($other->metrics()['requests']['in_flight'])->toBe(0);
+
+    \Cassandra\Futures::all($futures);
+    $session->execute("SELECT * FROM $table");
+
+    // Callbacks may still be running once the results are available
+    for ($wait = 0; $wait < 500 && $session->metrics()['requests']['in_flight'] > 0; $wait++) {
+        usleep(10000);
+    }
+
+    expect($session->metrics()['requests']['in_flight'])->toBe(0);
+});
@@ -112,3 +112,12 @@ test('Simple CQL strings can also be used in batch statements',
             expect($fullValue)->toBe($expectations[$key]);
         }
     });
+
+test('Numeric column names are returned as integer keys', function () use($keyspace, $table) {
+    $session = scyllaDbConnection($keyspace);
+    $row = $session->execute("SELECT title AS \"1\", album FROM $table WHERE id = 62c36092-82a1-3a00-93d1-46196ee77204 LIMIT 1")
+        ->first();
+
+    expect(array_keys($row))->toBe([1, 'album'])
+        ->and($row[1])->toBe('Die Mösch');
+});
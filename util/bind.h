@@ -0,0 +1,57 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cassandra.h>
+#include <php.h>
+#include <php_driver_types.h>
+
+/* Bind position of a single argument. Arguments are bound by index unless
+ * their name could not be resolved to one, in which case `name` is set.
+ */
+typedef struct {
+  CassStatement* statement;
+  size_t index;
+  const char* name;
+  size_t name_length;
+  /* Type of the prepared parameter bound by index, NULL when it isn't known */
+  const CassDataType* data_type;
+} php_driver_bind_target;
+
+typedef int (*php_driver_binder)(php_driver_bind_target* target, zval* value);
+
+/* Parameter metadata of a prepared statement, resolved once per statement:
+ * parameter names to indices and a binder per parameter that converts PHP
+ * scalars and arrays directly to the parameter's CQL type.
+ */
+typedef struct php_driver_bind_parameters_ {
+  HashTable names;
+  size_t count;
+  php_driver_binder* binders;
+} php_driver_bind_parameters;
+
+void php_driver_bind_startup();
+void php_driver_bind_shutdown();
+
+int php_driver_bind_value(php_driver_bind_target* target, zval* value);
+int php_driver_bind_arguments(CassStatement* statement, php_driver_statement* prepared,
+                              HashTable* arguments);
+/* Index of a named parameter of a prepared statement, -1 when the driver has to resolve it */
+zend_long php_driver_bind_parameter_index(php_driver_statement* prepared, zend_string* name);
+/* Creates a driver statement for a simple or prepared statement and binds its arguments */
+CassStatement* php_driver_create_statement(php_driver_statement* statement, HashTable* arguments);
+
+void php_driver_bind_parameters_free(php_driver_bind_parameters* parameters);
@@ -20,7 +20,15 @@
 #include <php_driver_types.h>
 
 int php_driver_validate_object(zval* object, zval* ztype);
+/* Validates every element of an array against the same type, rejecting nulls
+ * with "Invalid <kind>: null is not supported inside <container>" */
+int php_driver_validate_array(HashTable* values, zval* ztype, const char* kind,
+                              const char* container);
 int php_driver_value_type(char* type, CassValueType* value_type);
+/* Value class of a scalar type, NULL for PHP native and composite types */
+zend_class_entry* php_driver_value_class(CassValueType type);
+/* Appends a value already validated against type */
+int php_driver_collection_append(CassCollection* collection, zval* value, CassValueType type);
 
 int php_driver_collection_from_set(php_driver_set* set, CassCollection** collection_ptr);
 int php_driver_collection_from_collection(php_driver_collection* coll, CassCollection** collection_ptr);
@@ -17,6 +17,75 @@
 
 #include <cassandra.h>
 #include <php.h>
+#include <php_driver_types.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+int php_driver_future_parse_timeout(zval* timeout, cass_duration_t* timeout_us);
 int php_driver_future_wait_timed(CassFuture* future, zval* timeout);
+/* Part of a timeout left since start, 0 when there is no timeout. An expired
+ * timeout leaves 1 microsecond so that it isn't mistaken for no timeout.
+ */
+cass_duration_t php_driver_future_time_left(cass_duration_t timeout_us,
+                                            std::chrono::steady_clock::time_point start);
 int php_driver_future_is_error(CassFuture* future);
+
+/* Requests sent through a session that haven't completed yet, shared with
+ * the callbacks of those requests
+ */
+typedef struct php_driver_future_counter_ php_driver_future_counter;
+
+php_driver_future_counter* php_driver_future_counter_new();
+php_driver_future_counter* php_driver_future_counter_add_ref(php_driver_future_counter* counter);
+void php_driver_future_counter_release(php_driver_future_counter** counter);
+cass_int64_t php_driver_future_counter_in_flight(php_driver_future_counter* counter);
+/* Counts a request completing through a callback of its own, the returned
+ * reference is given back to php_driver_future_counter_done() from it
+ */
+php_driver_future_counter* php_driver_future_counter_start(php_driver_future_counter* counter);
+void php_driver_future_counter_done(php_driver_future_counter** counter);
+
+/* Completion of a tracked future, shared by its driver callback and the
+ * object owning the future
+ */
+typedef struct php_driver_future_state_ php_driver_future_state;
+
+/* Counts a request as in flight until its future resolves and returns the
+ * state its completion is watched through, the counter may be NULL
+ */
+php_driver_future_state* php_driver_future_track(CassFuture* future,
+                                                 php_driver_future_counter* counter);
+/* Counts a request whose completion isn't watched */
+void php_driver_future_count(CassFuture* future, php_driver_future_counter* counter);
+void php_driver_future_state_release(php_driver_future_state** state);
+
+/* Futures completed while a thread waits on them, in completion order. Only
+ * the futures watched by the queue are reported to it.
+ */
+struct php_driver_future_queue {
+  std::mutex mutex;
+  std::condition_variable ready;
+  std::deque<CassFuture*> completed;
+  std::vector<php_driver_future_state*> watched;
+};
+
+/* Reports the completion of a tracked future to the queue */
+void php_driver_future_queue_watch(php_driver_future_queue* queue, php_driver_future_state* state);
+/* Stops watching every future, nothing is reported to the queue afterwards */
+void php_driver_future_queue_close(php_driver_future_queue* queue);
+/* Next completed future, NULL once the timeout expires (0 waits forever) */
+CassFuture* php_driver_future_queue_next(php_driver_future_queue* queue, cass_duration_t timeout_us);
+
+/* Keeps a statement referenced until the request sending it completes, for
+ * futures destroyed while their request is pending. Bound statements and
+ * batches are only modified in place when nothing else references them.
+ */
+void php_driver_future_release_later(CassFuture* future, php_driver_ref* statement);
+/* Releases the statements of completed requests, or of every request without
+ * waiting for them when all is set.
+ */
+void php_driver_future_release_completed(zend_bool all);
@@ -17,35 +17,7 @@
 
 #include "inline.h"
 #include <php_driver.h>
-
-#define uthash_malloc(sz) emalloc(sz)
-#define uthash_free(ptr, sz) efree(ptr)
-
-#define HASH_FUNCTION(key, keylen, num_bkts, hashv, bkt)                                                               \
-    hashv = php_driver_value_hash((zval *)key);                                                                        \
-    bkt = (hashv) & (num_bkts - 1U)
-#define HASH_KEYCOMPARE(a, b, len) php_driver_value_compare((zval *)a, (zval *)b)
-
-#undef HASH_ADD /* Previously defined in Zend/zend_hash.h */
-
-#include "uthash.h"
-
-#define HASH_FIND_ZVAL(head, zvptr, out) HASH_FIND(hh, head, zvptr, 0, out)
-
-#define HASH_ADD_ZVAL(head, fieldname, add) HASH_ADD_KEYPTR(hh, head, &((add->fieldname)), 0, add)
-
-struct php_driver_map_entry_
-{
-    zval key;
-    zval value;
-    UT_hash_handle hh;
-};
-
-struct php_driver_set_entry_
-{
-    zval value;
-    UT_hash_handle hh;
-};
+#include <php_driver_types.h>
 
 #define PHP_DRIVER_COMPARE(a, b) ((a) < (b) ? -1 : (a) > (b))
 
@@ -63,3 +35,62 @@ static PHP_DRIVER_ALWAYS_INLINE uint32_t php_driver_combine_hash(unsigned seed,
 {
     return seed ^ (hashv + 0x9e3779b9 + (seed << 6) + (seed >> 2));
 }
+
+/* Collections, tuples and user type values cache their hash until they are
+ * mutated, and count their mutations in version. A value holding other such
+ * values keeps the sum of their versions from when it was hashed, its cached
+ * hash holds while that sum and their own cached hashes hold. */
+#define PHP_DRIVER_HASH_CACHED(self, nested_cached) (!(self)->dirty && (!(self)->hash_nested || (nested_cached)))
+
+#define PHP_DRIVER_HASH_STORE(self, hashv, nested, version)                                                            \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        (self)->hashv = (hashv);                                                                                       \
+        (self)->hash_nested = (nested);                                                                                \
+        (self)->hash_version = (version);                                                                              \
+        (self)->dirty = 0;                                                                                             \
+    } while (0)
+
+#define PHP_DRIVER_VALUE_MUTATED(self)                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        (self)->dirty = 1;                                                                                             \
+        (self)->version++;                                                                                             \
+    } while (0)
+
+zend_ulong php_driver_value_version(zval *value);
+zend_bool php_driver_value_hash_cached(zval *value);
+zend_bool php_driver_nested_hash_cached(HashTable *values, zend_ulong version);
+zend_bool php_driver_flat_nested_hash_cached(php_driver_flat_hash *table, zend_ulong version);
+
+static PHP_DRIVER_ALWAYS_INLINE int php_driver_value_is_nested(zval *value)
+{
+    zend_class_entry *ce;
+
+    if (Z_TYPE_P(value) != IS_OBJECT)
+        return 0;
+
+    ce = Z_OBJCE_P(value);
+    return ce == php_driver_collection_ce || ce == php_driver_map_ce || ce == php_driver_set_ce ||
+           ce == php_driver_tuple_ce || ce == php_driver_user_type_value_ce;
+}
+
+#define PHP_DRIVER_FLAT_HASH_FOREACH(table, entry)                                                                     \
+    for ((entry) = (table)->entries; (entry) < (table)->entries + (table)->used; (entry)++)                            \
+        if (!Z_ISUNDEF((entry)->key))
+
+void php_driver_flat_hash_init(php_driver_flat_hash *table);
+void php_driver_flat_hash_destroy(php_driver_flat_hash *table);
+/* Grows the table so that it holds at least size entries without rehashing */
+void php_driver_flat_hash_reserve(php_driver_flat_hash *table, uint32_t size);
+php_driver_flat_entry *php_driver_flat_hash_find(php_driver_flat_hash *table, zval *key);
+/* Same as php_driver_flat_hash_find() with the hash of key already known */
+php_driver_flat_entry *php_driver_flat_hash_find_hash(php_driver_flat_hash *table, zval *key, uint32_t hash);
+/* Returns the entry of key, appending one with a copy of the key and an
+ * undefined value when it is missing. Appending may compact the entries,
+ * moving the iterator position pos along when it is given. */
+php_driver_flat_entry *php_driver_flat_hash_add(php_driver_flat_hash *table, zval *key, zend_bool *added,
+                                                uint32_t *pos);
+int php_driver_flat_hash_del(php_driver_flat_hash *table, zval *key);
+/* Position of the first entry at or after pos, table->used when there is none */
+uint32_t php_driver_flat_hash_next(php_driver_flat_hash *table, uint32_t pos);
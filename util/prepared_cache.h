@@ -0,0 +1,63 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cassandra.h>
+#include <php.h>
+
+typedef struct php_driver_prepared_cache_entry_ {
+  zend_ulong hash;
+  zend_ulong scope;
+  zend_string* cql;
+  CassFuture* future;
+  struct php_driver_prepared_cache_entry_* prev;
+  struct php_driver_prepared_cache_entry_* next;
+} php_driver_prepared_cache_entry;
+
+/* Prepared statements of persistent sessions, shared by every request served
+ * by the process and evicted in least recently used order.
+ */
+typedef struct php_driver_prepared_cache_ {
+  HashTable entries;
+  php_driver_prepared_cache_entry* head;
+  php_driver_prepared_cache_entry* tail;
+  zend_ulong hits;
+  zend_ulong misses;
+  zend_ulong evictions;
+} php_driver_prepared_cache;
+
+php_driver_prepared_cache* php_driver_prepared_cache_new();
+void php_driver_prepared_cache_free(php_driver_prepared_cache* cache);
+
+/* Hashes the persistent key of a session, computed once when it connects */
+zend_ulong php_driver_prepared_cache_scope(const char* hash_key, size_t hash_key_len);
+zend_ulong php_driver_prepared_cache_hash(zend_ulong scope, zend_string* cql);
+
+/* Returns the prepare future of a cached statement, NULL on a miss. The future
+ * is owned by the cache.
+ */
+CassFuture* php_driver_prepared_cache_find(php_driver_prepared_cache* cache, zend_ulong hash,
+                                           zend_ulong scope, zend_string* cql);
+
+/* Takes ownership of a successful prepare future and evicts the least recently
+ * used statements above capacity. Returns FAILURE when the cache is disabled,
+ * the future then remains owned by the caller.
+ */
+int php_driver_prepared_cache_add(php_driver_prepared_cache* cache, zend_ulong hash,
+                                  zend_ulong scope, zend_string* cql, CassFuture* future,
+                                  zend_long capacity);
+
+void php_driver_prepared_cache_trim(php_driver_prepared_cache* cache, zend_long capacity);
@@ -18,10 +18,47 @@
 #include <cassandra.h>
 #include <php_driver_types.h>
 
+/* Execution options decoding top-level columns into plain PHP values instead
+ * of value objects. Each option keeps its own bit, the decoders they select are
+ * only combined when a result's decoder plan is built.
+ */
+#define PHP_DRIVER_NATIVE_SCALARS (1 << 0)
+#define PHP_DRIVER_NATIVE_INTEGERS (1 << 1)
+
+typedef struct php_driver_decoder_ php_driver_decoder;
+typedef int (*php_driver_decode_function)(const php_driver_decoder* decoder, const CassValue* value,
+                                          php_driver_ref* result, zval* out);
+
+/* Decodes values of one column (or element type), resolved once from the result metadata */
+struct php_driver_decoder_
+{
+    php_driver_decode_function decode;
+    CassValueType value_type;
+    zval type;
+    size_t count;
+    php_driver_decoder* sub;
+};
+
+typedef struct
+{
+    size_t count;
+    int options;
+    cass_bool_t unique;
+    /* Names such as "1" become integer keys, like in any PHP array */
+    cass_bool_t numeric;
+    zend_string** names;
+    php_driver_decoder* decoders;
+} php_driver_result_columns;
+
 int php_driver_value(const CassValue* value, const CassDataType* data_type, zval* out);
 
 int php_driver_get_keyspace_field(const CassKeyspaceMeta* metadata, const char* field_name, zval* out);
 int php_driver_get_table_field(const CassTableMeta* metadata, const char* field_name, zval* out);
 int php_driver_get_column_field(const CassColumnMeta* metadata, const char* field_name, zval* out);
 
+php_driver_ref* php_driver_result_columns_get(const CassResult* result, php_driver_ref* cached, int options);
+int php_driver_get_row(const php_driver_result_columns* columns, const CassRow* row, php_driver_ref* result,
+                       zval* out);
+int php_driver_get_column(const php_driver_result_columns* columns, const CassResult* cass_result, size_t index,
+                          php_driver_ref* result, zval* out);
 int php_driver_get_result(const CassResult* result, zval* out);
@@ -0,0 +1,727 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <DateTime/Date.h>
+#include <php_driver.h>
+#include <php_driver_types.h>
+#include <util/bind.h>
+#include <util/collections.h>
+#include <util/math.h>
+#include <util/types.h>
+
+#define BIND_RESULT(rc)                  \
+  do {                                   \
+    ASSERT_SUCCESS_VALUE(rc, FAILURE);   \
+    return SUCCESS;                      \
+  } while (0)
+
+#define BIND(target, kind, ...)                                                       \
+  ((target)->name ? cass_statement_bind_##kind##_by_name_n((target)->statement,       \
+                                                          (target)->name,             \
+                                                          (target)->name_length,      \
+                                                          __VA_ARGS__)                \
+                  : cass_statement_bind_##kind((target)->statement, (target)->index, \
+                                               __VA_ARGS__))
+
+/* Maps a value class entry to its binder, filled once at module startup */
+static HashTable php_driver_binders;
+
+static int bind_float(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, float, PHP_DRIVER_GET_NUMERIC(value)->data.floating.value));
+}
+
+static int bind_bigint(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, int64, PHP_DRIVER_GET_NUMERIC(value)->data.bigint.value));
+}
+
+static int bind_smallint(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, int16, PHP_DRIVER_GET_NUMERIC(value)->data.smallint.value));
+}
+
+static int bind_tinyint(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, int8, PHP_DRIVER_GET_NUMERIC(value)->data.tinyint.value));
+}
+
+static int bind_timestamp(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, int64, Z_SCYLLADB_TIMESTAMP_P(value)->timestamp));
+}
+
+static int bind_date(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, uint32, Z_SCYLLADB_DATE_P(value)->date));
+}
+
+static int bind_time(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, int64, Z_SCYLLADB_TIME_P(value)->time));
+}
+
+static int bind_blob(php_driver_bind_target* target, zval* value) {
+  php_driver_blob* blob = PHP_DRIVER_GET_BLOB(value);
+  BIND_RESULT(BIND(target, bytes, blob->data, blob->size));
+}
+
+static int bind_varint(php_driver_bind_target* target, zval* value) {
+  size_t size;
+  cass_byte_t* data =
+      export_twos_complement(PHP_DRIVER_GET_NUMERIC(value)->data.varint.value, &size);
+  CassError rc = BIND(target, bytes, data, size);
+  free(data);
+  BIND_RESULT(rc);
+}
+
+static int bind_decimal(php_driver_bind_target* target, zval* value) {
+  php_driver_numeric* decimal = PHP_DRIVER_GET_NUMERIC(value);
+  size_t size;
+  cass_byte_t* data = export_twos_complement(decimal->data.decimal.value, &size);
+  CassError rc = BIND(target, decimal, data, size, decimal->data.decimal.scale);
+  free(data);
+  BIND_RESULT(rc);
+}
+
+static int bind_uuid(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, uuid, PHP_DRIVER_GET_UUID(value)->uuid));
+}
+
+static int bind_inet(php_driver_bind_target* target, zval* value) {
+  BIND_RESULT(BIND(target, inet, PHP_DRIVER_GET_INET(value)->inet));
+}
+
+static int bind_duration(php_driver_bind_target* target, zval* value) {
+  php_driver_duration* duration = PHP_DRIVER_GET_DURATION(value);
+  BIND_RESULT(BIND(target, duration, duration->months, duration->days, duration->nanos));
+}
+
+static int bind_set(php_driver_bind_target* target, zval* value) {
+  CassError rc;
+  CassCollection* collection;
+  if (!php_driver_collection_from_set(PHP_DRIVER_GET_SET(value), &collection)) return FAILURE;
+
+  rc = BIND(target, collection, collection);
+  cass_collection_free(collection);
+  BIND_RESULT(rc);
+}
+
+static int bind_map(php_driver_bind_target* target, zval* value) {
+  CassError rc;
+  CassCollection* collection;
+  if (!php_driver_collection_from_map(PHP_DRIVER_GET_MAP(value), &collection)) return FAILURE;
+
+  rc = BIND(target, collection, collection);
+  cass_collection_free(collection);
+  BIND_RESULT(rc);
+}
+
+static int bind_collection(php_driver_bind_target* target, zval* value) {
+  CassError rc;
+  CassCollection* collection;
+  if (!php_driver_collection_from_collection(PHP_DRIVER_GET_COLLECTION(value), &collection))
+    return FAILURE;
+
+  rc = BIND(target, collection, collection);
+  cass_collection_free(collection);
+  BIND_RESULT(rc);
+}
+
+static int bind_tuple(php_driver_bind_target* target, zval* value) {
+  CassError rc;
+  CassTuple* tuple;
+  if (!php_driver_tuple_from_tuple(PHP_DRIVER_GET_TUPLE(value), &tuple)) return FAILURE;
+
+  rc = BIND(target, tuple, tuple);
+  cass_tuple_free(tuple);
+  BIND_RESULT(rc);
+}
+
+static int bind_user_type(php_driver_bind_target* target, zval* value) {
+  CassError rc;
+  CassUserType* user_type;
+  if (!php_driver_user_type_from_user_type_value(PHP_DRIVER_GET_USER_TYPE_VALUE(value),
+                                                 &user_type))
+    return FAILURE;
+
+  rc = BIND(target, user_type, user_type);
+  cass_user_type_free(user_type);
+  BIND_RESULT(rc);
+}
+
+static void php_driver_binder_register(zend_class_entry* ce, php_driver_binder binder) {
+  zend_hash_index_update_ptr(&php_driver_binders, (zend_ulong)(uintptr_t)ce, (void*)binder);
+}
+
+void php_driver_bind_startup() {
+  zend_hash_init(&php_driver_binders, 32, NULL, NULL, 1);
+
+  php_driver_binder_register(php_driver_float_ce, bind_float);
+  php_driver_binder_register(php_driver_bigint_ce, bind_bigint);
+  php_driver_binder_register(php_driver_smallint_ce, bind_smallint);
+  php_driver_binder_register(php_driver_tinyint_ce, bind_tinyint);
+  php_driver_binder_register(php_scylladb_timestamp_ce, bind_timestamp);
+  php_driver_binder_register(php_scylladb_date_ce, bind_date);
+  php_driver_binder_register(php_scylladb_time_ce, bind_time);
+  php_driver_binder_register(php_driver_blob_ce, bind_blob);
+  php_driver_binder_register(php_driver_varint_ce, bind_varint);
+  php_driver_binder_register(php_driver_decimal_ce, bind_decimal);
+  php_driver_binder_register(php_driver_uuid_ce, bind_uuid);
+  php_driver_binder_register(php_driver_timeuuid_ce, bind_uuid);
+  php_driver_binder_register(php_driver_inet_ce, bind_inet);
+  php_driver_binder_register(php_driver_duration_ce, bind_duration);
+  php_driver_binder_register(php_driver_set_ce, bind_set);
+  php_driver_binder_register(php_driver_map_ce, bind_map);
+  php_driver_binder_register(php_driver_collection_ce, bind_collection);
+  php_driver_binder_register(php_driver_tuple_ce, bind_tuple);
+  php_driver_binder_register(php_driver_user_type_value_ce, bind_user_type);
+}
+
+void php_driver_bind_shutdown() { zend_hash_destroy(&php_driver_binders); }
+
+static php_driver_binder php_driver_binder_find(zend_class_entry* ce) {
+  php_driver_binder binder =
+      (php_driver_binder)zend_hash_index_find_ptr(&php_driver_binders, (zend_ulong)(uintptr_t)ce);
+
+  if (binder) return binder;
+
+  /* Classes derived from or implementing a value type (e.g. other UuidInterface
+   * implementations) are not registered, so fall back to an instanceof check.
+   */
+  if (instanceof_function(ce, php_driver_uuid_interface_ce)) return bind_uuid;
+
+  return NULL;
+}
+
+int php_driver_bind_value(php_driver_bind_target* target, zval* value) {
+  php_driver_binder binder;
+
+  switch (Z_TYPE_P(value)) {
+    case IS_NULL:
+      BIND_RESULT(target->name ? cass_statement_bind_null_by_name_n(
+                                     target->statement, target->name, target->name_length)
+                               : cass_statement_bind_null(target->statement, target->index));
+    case IS_STRING:
+      BIND_RESULT(target->name ? cass_statement_bind_string_by_name_n(
+                                     target->statement, target->name, target->name_length,
+                                     Z_STRVAL_P(value), Z_STRLEN_P(value))
+                               : cass_statement_bind_string_n(target->statement, target->index,
+                                                              Z_STRVAL_P(value),
+                                                              Z_STRLEN_P(value)));
+    case IS_DOUBLE:
+      BIND_RESULT(BIND(target, double, Z_DVAL_P(value)));
+    case IS_LONG:
+      BIND_RESULT(BIND(target, int32, (cass_int32_t)Z_LVAL_P(value)));
+    case IS_TRUE:
+      BIND_RESULT(BIND(target, bool, cass_true));
+    case IS_FALSE:
+      BIND_RESULT(BIND(target, bool, cass_false));
+    case IS_OBJECT:
+      binder = php_driver_binder_find(Z_OBJCE_P(value));
+      if (binder) return binder(target, value);
+      break;
+    default:
+      break;
+  }
+
+  return FAILURE;
+}
+
+static int check_long_range(zval* value, zend_long min, zend_long max, const char* type) {
+  if (Z_LVAL_P(value) < min || Z_LVAL_P(value) > max) {
+    zend_throw_exception_ex(php_driver_range_exception_ce, 0,
+                            "%s value must be between " ZEND_LONG_FMT " and " ZEND_LONG_FMT
+                            ", " ZEND_LONG_FMT " given",
+                            type, min, max, Z_LVAL_P(value));
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+/* Typed binders for prepared parameters. They convert PHP scalars to the
+ * parameter's CQL type and defer anything else to php_driver_bind_value().
+ */
+static int bind_typed_int(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) != IS_LONG) return php_driver_bind_value(target, value);
+  if (check_long_range(value, INT32_MIN, INT32_MAX, "int") == FAILURE) return FAILURE;
+  BIND_RESULT(
+      cass_statement_bind_int32(target->statement, target->index, (cass_int32_t)Z_LVAL_P(value)));
+}
+
+static int bind_typed_int64(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) != IS_LONG) return php_driver_bind_value(target, value);
+  BIND_RESULT(
+      cass_statement_bind_int64(target->statement, target->index, (cass_int64_t)Z_LVAL_P(value)));
+}
+
+static int bind_typed_smallint(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) != IS_LONG) return php_driver_bind_value(target, value);
+  if (check_long_range(value, INT16_MIN, INT16_MAX, "smallint") == FAILURE) return FAILURE;
+  BIND_RESULT(
+      cass_statement_bind_int16(target->statement, target->index, (cass_int16_t)Z_LVAL_P(value)));
+}
+
+static int bind_typed_tinyint(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) != IS_LONG) return php_driver_bind_value(target, value);
+  if (check_long_range(value, INT8_MIN, INT8_MAX, "tinyint") == FAILURE) return FAILURE;
+  BIND_RESULT(
+      cass_statement_bind_int8(target->statement, target->index, (cass_int8_t)Z_LVAL_P(value)));
+}
+
+static int bind_typed_float(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) == IS_DOUBLE)
+    BIND_RESULT(cass_statement_bind_float(target->statement, target->index,
+                                          (cass_float_t)Z_DVAL_P(value)));
+  if (Z_TYPE_P(value) == IS_LONG)
+    BIND_RESULT(cass_statement_bind_float(target->statement, target->index,
+                                          (cass_float_t)Z_LVAL_P(value)));
+  return php_driver_bind_value(target, value);
+}
+
+static int bind_typed_double(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) == IS_LONG)
+    BIND_RESULT(cass_statement_bind_double(target->statement, target->index,
+                                           (cass_double_t)Z_LVAL_P(value)));
+  return php_driver_bind_value(target, value);
+}
+
+static int parse_uuid(zval* value, CassUuid* uuid) {
+  if (cass_uuid_from_string_n(Z_STRVAL_P(value), Z_STRLEN_P(value), uuid) != CASS_OK) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0, "Invalid UUID: '%.*s'",
+                            (int)Z_STRLEN_P(value), Z_STRVAL_P(value));
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+static int parse_inet(zval* value, CassInet* inet) {
+  if (cass_inet_from_string_n(Z_STRVAL_P(value), Z_STRLEN_P(value), inet) != CASS_OK) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Invalid IP address: '%.*s'", (int)Z_STRLEN_P(value),
+                            Z_STRVAL_P(value));
+    return FAILURE;
+  }
+
+  return SUCCESS;
+}
+
+static int bind_typed_uuid(php_driver_bind_target* target, zval* value) {
+  CassUuid uuid;
+
+  if (Z_TYPE_P(value) != IS_STRING) return php_driver_bind_value(target, value);
+  if (parse_uuid(value, &uuid) == FAILURE) return FAILURE;
+  BIND_RESULT(cass_statement_bind_uuid(target->statement, target->index, uuid));
+}
+
+static int bind_typed_inet(php_driver_bind_target* target, zval* value) {
+  CassInet inet;
+
+  if (Z_TYPE_P(value) != IS_STRING) return php_driver_bind_value(target, value);
+  if (parse_inet(value, &inet) == FAILURE) return FAILURE;
+  BIND_RESULT(cass_statement_bind_inet(target->statement, target->index, inet));
+}
+
+static int bind_typed_blob(php_driver_bind_target* target, zval* value) {
+  if (Z_TYPE_P(value) != IS_STRING) return php_driver_bind_value(target, value);
+  BIND_RESULT(cass_statement_bind_bytes(target->statement, target->index,
+                                        (const cass_byte_t*)Z_STRVAL_P(value), Z_STRLEN_P(value)));
+}
+
+static int collection_from_array(const CassDataType* data_type, HashTable* values,
+                                 CassCollection** collection_ptr);
+
+static int append_object(CassCollection* collection, const CassDataType* data_type,
+                         zval* value) {
+  CassValueType type = cass_data_type_type(data_type);
+  zend_class_entry* ce = php_driver_value_class(type);
+
+  if (ce) {
+    if (!instanceof_function(Z_OBJCE_P(value), ce)) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Invalid value: expected an instance of %s, %s given",
+                              ZSTR_VAL(ce->name), ZSTR_VAL(Z_OBJCE_P(value)->name));
+      return FAILURE;
+    }
+  } else {
+    /* Composite values carry their own type, which has to match the parameter's */
+    zval ztype = php_driver_type_from_data_type(data_type);
+    int valid = php_driver_validate_object(value, &ztype);
+    zval_ptr_dtor(&ztype);
+
+    if (!valid) {
+      if (!EG(exception))
+        zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                                "Invalid value: %s doesn't match the collection element type",
+                                ZSTR_VAL(Z_OBJCE_P(value)->name));
+      return FAILURE;
+    }
+  }
+
+  return php_driver_collection_append(collection, value, type) ? SUCCESS : FAILURE;
+}
+
+/* Appends a PHP value to a collection using the element type of the prepared
+ * parameter, with the same conversions as the typed binders.
+ */
+static int append_typed(CassCollection* collection, const CassDataType* data_type, zval* value) {
+  CassValueType type = cass_data_type_type(data_type);
+  CassUuid uuid;
+  CassInet inet;
+
+  ZVAL_DEREF(value);
+
+  switch (Z_TYPE_P(value)) {
+    case IS_NULL:
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Invalid value: null is not supported inside collections");
+      return FAILURE;
+    case IS_ARRAY:
+      if (type == CASS_VALUE_TYPE_LIST || type == CASS_VALUE_TYPE_SET ||
+          type == CASS_VALUE_TYPE_MAP) {
+        CassCollection* sub_collection;
+        CassError rc;
+
+        if (collection_from_array(data_type, Z_ARRVAL_P(value), &sub_collection) == FAILURE)
+          return FAILURE;
+
+        rc = cass_collection_append_collection(collection, sub_collection);
+        cass_collection_free(sub_collection);
+        BIND_RESULT(rc);
+      }
+      break;
+    case IS_STRING:
+      switch (type) {
+        case CASS_VALUE_TYPE_TEXT:
+        case CASS_VALUE_TYPE_VARCHAR:
+        case CASS_VALUE_TYPE_ASCII:
+          BIND_RESULT(
+              cass_collection_append_string_n(collection, Z_STRVAL_P(value), Z_STRLEN_P(value)));
+        case CASS_VALUE_TYPE_BLOB:
+          BIND_RESULT(cass_collection_append_bytes(
+              collection, (const cass_byte_t*)Z_STRVAL_P(value), Z_STRLEN_P(value)));
+        case CASS_VALUE_TYPE_UUID:
+        case CASS_VALUE_TYPE_TIMEUUID:
+          if (parse_uuid(value, &uuid) == FAILURE) return FAILURE;
+          BIND_RESULT(cass_collection_append_uuid(collection, uuid));
+        case CASS_VALUE_TYPE_INET:
+          if (parse_inet(value, &inet) == FAILURE) return FAILURE;
+          BIND_RESULT(cass_collection_append_inet(collection, inet));
+        default:
+          break;
+      }
+      break;
+    case IS_LONG:
+      switch (type) {
+        case CASS_VALUE_TYPE_INT:
+          if (check_long_range(value, INT32_MIN, INT32_MAX, "int") == FAILURE) return FAILURE;
+          BIND_RESULT(cass_collection_append_int32(collection, (cass_int32_t)Z_LVAL_P(value)));
+        case CASS_VALUE_TYPE_BIGINT:
+        case CASS_VALUE_TYPE_COUNTER:
+        case CASS_VALUE_TYPE_TIMESTAMP:
+        case CASS_VALUE_TYPE_TIME:
+          BIND_RESULT(cass_collection_append_int64(collection, (cass_int64_t)Z_LVAL_P(value)));
+        case CASS_VALUE_TYPE_SMALL_INT:
+          if (check_long_range(value, INT16_MIN, INT16_MAX, "smallint") == FAILURE)
+            return FAILURE;
+          BIND_RESULT(cass_collection_append_int16(collection, (cass_int16_t)Z_LVAL_P(value)));
+        case CASS_VALUE_TYPE_TINY_INT:
+          if (check_long_range(value, INT8_MIN, INT8_MAX, "tinyint") == FAILURE) return FAILURE;
+          BIND_RESULT(cass_collection_append_int8(collection, (cass_int8_t)Z_LVAL_P(value)));
+        case CASS_VALUE_TYPE_FLOAT:
+          BIND_RESULT(cass_collection_append_float(collection, (cass_float_t)Z_LVAL_P(value)));
+        case CASS_VALUE_TYPE_DOUBLE:
+          BIND_RESULT(cass_collection_append_double(collection, (cass_double_t)Z_LVAL_P(value)));
+        default:
+          break;
+      }
+      break;
+    case IS_DOUBLE:
+      if (type == CASS_VALUE_TYPE_DOUBLE)
+        BIND_RESULT(cass_collection_append_double(collection, Z_DVAL_P(value)));
+      if (type == CASS_VALUE_TYPE_FLOAT)
+        BIND_RESULT(cass_collection_append_float(collection, (cass_float_t)Z_DVAL_P(value)));
+      break;
+    case IS_TRUE:
+    case IS_FALSE:
+      if (type == CASS_VALUE_TYPE_BOOLEAN)
+        BIND_RESULT(cass_collection_append_bool(
+            collection, Z_TYPE_P(value) == IS_TRUE ? cass_true : cass_false));
+      break;
+    case IS_OBJECT:
+      return append_object(collection, data_type, value);
+    default:
+      break;
+  }
+
+  zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                          "Invalid value: %s is not supported for this collection element type",
+                          zend_zval_type_name(value));
+  return FAILURE;
+}
+
+/* Encodes a PHP array straight into a collection of a prepared parameter. List
+ * and set elements are the array values, map entries are its keys and values.
+ */
+static int collection_from_array(const CassDataType* data_type, HashTable* values,
+                                 CassCollection** collection_ptr) {
+  CassValueType type = cass_data_type_type(data_type);
+  const CassDataType* first_type = cass_data_type_sub_data_type(data_type, 0);
+  const CassDataType* value_type =
+      type == CASS_VALUE_TYPE_MAP ? cass_data_type_sub_data_type(data_type, 1) : NULL;
+  CassValueType key_type;
+  CassCollection* collection;
+  zend_ulong num_key;
+  zend_string* str_key;
+  zval* current;
+
+  if (!first_type || (type == CASS_VALUE_TYPE_MAP && !value_type)) {
+    zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                            "Invalid value: the element type of the collection is unknown");
+    return FAILURE;
+  }
+
+  key_type = cass_data_type_type(first_type);
+  collection = cass_collection_new_from_data_type(data_type, zend_hash_num_elements(values));
+
+  ZEND_HASH_FOREACH_KEY_VAL(values, num_key, str_key, current) {
+    int rc;
+
+    if (value_type) {
+      zval key;
+
+      /* PHP turns numeric string keys into integers, convert them back for text keys */
+      if (str_key) {
+        ZVAL_STR(&key, str_key);
+      } else if (key_type == CASS_VALUE_TYPE_TEXT || key_type == CASS_VALUE_TYPE_VARCHAR ||
+                 key_type == CASS_VALUE_TYPE_ASCII) {
+        ZVAL_STR(&key, zend_long_to_str((zend_long)num_key));
+      } else {
+        ZVAL_LONG(&key, (zend_long)num_key);
+      }
+
+      rc = append_typed(collection, first_type, &key);
+      if (!str_key) zval_ptr_dtor(&key);
+      if (rc == SUCCESS) rc = append_typed(collection, value_type, current);
+    } else {
+      rc = append_typed(collection, first_type, current);
+    }
+
+    if (rc == FAILURE) {
+      cass_collection_free(collection);
+      return FAILURE;
+    }
+  }
+  ZEND_HASH_FOREACH_END();
+
+  *collection_ptr = collection;
+  return SUCCESS;
+}
+
+static int bind_typed_collection(php_driver_bind_target* target, zval* value) {
+  CassCollection* collection;
+  CassError rc;
+
+  if (Z_TYPE_P(value) != IS_ARRAY || !target->data_type)
+    return php_driver_bind_value(target, value);
+
+  if (collection_from_array(target->data_type, Z_ARRVAL_P(value), &collection) == FAILURE)
+    return FAILURE;
+
+  rc = cass_statement_bind_collection(target->statement, target->index, collection);
+  cass_collection_free(collection);
+  BIND_RESULT(rc);
+}
+
+static php_driver_binder php_driver_binder_for_type(const CassDataType* data_type) {
+  switch (data_type ? cass_data_type_type(data_type) : CASS_VALUE_TYPE_UNKNOWN) {
+    case CASS_VALUE_TYPE_INT:
+      return bind_typed_int;
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_TIME:
+      return bind_typed_int64;
+    case CASS_VALUE_TYPE_SMALL_INT:
+      return bind_typed_smallint;
+    case CASS_VALUE_TYPE_TINY_INT:
+      return bind_typed_tinyint;
+    case CASS_VALUE_TYPE_FLOAT:
+      return bind_typed_float;
+    case CASS_VALUE_TYPE_DOUBLE:
+      return bind_typed_double;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+      return bind_typed_uuid;
+    case CASS_VALUE_TYPE_INET:
+      return bind_typed_inet;
+    case CASS_VALUE_TYPE_BLOB:
+      return bind_typed_blob;
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_SET:
+    case CASS_VALUE_TYPE_MAP:
+      return bind_typed_collection;
+    default:
+      return php_driver_bind_value;
+  }
+}
+
+static php_driver_bind_parameters* php_driver_bind_parameters_get(php_driver_statement* prepared) {
+  php_driver_bind_parameters* parameters = prepared->data.prepared.parameters;
+  const char* name;
+  size_t name_length;
+  size_t index;
+
+  if (parameters) return parameters;
+
+  parameters = (php_driver_bind_parameters*)emalloc(sizeof(php_driver_bind_parameters));
+  zend_hash_init(&parameters->names, 8, NULL, NULL, 0);
+  parameters->count = 0;
+  parameters->binders = NULL;
+
+  for (index = 0; cass_prepared_parameter_name(prepared->data.prepared.prepared, index, &name,
+                                               &name_length) == CASS_OK;
+       index++) {
+    zend_string* original = zend_string_init(name, name_length, 0);
+    zend_string* key = zend_string_tolower(original);
+    zval* existing = zend_hash_find(&parameters->names, key);
+
+    /* Names used by several markers must bind all of them, leave those to the driver */
+    if (existing) {
+      ZVAL_LONG(existing, -1);
+    } else {
+      zval zindex;
+      ZVAL_LONG(&zindex, (zend_long)index);
+      zend_hash_add_new(&parameters->names, key, &zindex);
+    }
+    zend_string_release(key);
+    zend_string_release(original);
+  }
+
+  parameters->count = index;
+  if (parameters->count > 0) {
+    parameters->binders =
+        (php_driver_binder*)emalloc(parameters->count * sizeof(php_driver_binder));
+    for (index = 0; index < parameters->count; index++) {
+      parameters->binders[index] = php_driver_binder_for_type(
+          cass_prepared_parameter_data_type(prepared->data.prepared.prepared, index));
+    }
+  }
+
+  prepared->data.prepared.parameters = parameters;
+  return parameters;
+}
+
+static void php_driver_bind_target_resolve(php_driver_bind_target* target,
+                                           php_driver_bind_parameters* parameters,
+                                           zend_string* name) {
+  zval* index = NULL;
+
+  target->name = ZSTR_VAL(name);
+  target->name_length = ZSTR_LEN(name);
+
+  /* Quoted names are case-sensitive, let the driver resolve those */
+  if (!parameters || (ZSTR_LEN(name) > 0 && ZSTR_VAL(name)[0] == '"')) return;
+
+  index = zend_hash_find(&parameters->names, name);
+  if (!index) {
+    zend_string* lower = zend_string_tolower(name);
+    index = zend_hash_find(&parameters->names, lower);
+    zend_string_release(lower);
+  }
+
+  if (index && Z_LVAL_P(index) >= 0) {
+    target->name = NULL;
+    target->index = (size_t)Z_LVAL_P(index);
+  }
+}
+
+int php_driver_bind_arguments(CassStatement* statement, php_driver_statement* prepared,
+                              HashTable* arguments) {
+  php_driver_bind_parameters* parameters = NULL;
+  php_driver_bind_target target;
+  zend_ulong num_key;
+  zend_string* key;
+  zval* current;
+
+  target.statement = statement;
+
+  if (prepared) parameters = php_driver_bind_parameters_get(prepared);
+
+  ZEND_HASH_FOREACH_KEY_VAL(arguments, num_key, key, current) {
+    int rc;
+
+    target.index = num_key;
+    target.name = NULL;
+    target.name_length = 0;
+    target.data_type = NULL;
+
+    if (key) php_driver_bind_target_resolve(&target, parameters, key);
+
+    if (parameters && !target.name && target.index < parameters->count) {
+      target.data_type =
+          cass_prepared_parameter_data_type(prepared->data.prepared.prepared, target.index);
+      rc = parameters->binders[target.index](&target, current);
+    } else {
+      rc = php_driver_bind_value(&target, current);
+    }
+
+    if (rc == FAILURE) return FAILURE;
+  }
+  ZEND_HASH_FOREACH_END();
+
+  return SUCCESS;
+}
+
+zend_long php_driver_bind_parameter_index(php_driver_statement* prepared, zend_string* name) {
+  php_driver_bind_target target;
+
+  php_driver_bind_target_resolve(&target, php_driver_bind_parameters_get(prepared), name);
+
+  return target.name ? -1 : (zend_long)target.index;
+}
+
+CassStatement* php_driver_create_statement(php_driver_statement* statement, HashTable* arguments) {
+  CassStatement* stmt;
+  uint32_t count;
+
+  switch (statement->type) {
+    case PHP_DRIVER_SIMPLE_STATEMENT:
+      count = 0;
+
+      if (arguments) count = zend_hash_num_elements(arguments);
+
+      stmt = cass_statement_new(statement->data.simple.cql, count);
+      break;
+    case PHP_DRIVER_PREPARED_STATEMENT:
+      stmt = cass_prepared_bind(statement->data.prepared.prepared);
+      break;
+    default:
+      zend_throw_exception_ex(php_driver_runtime_exception_ce, 0, "Unsupported statement type.");
+      return NULL;
+  }
+
+  if (arguments &&
+      php_driver_bind_arguments(
+          stmt, statement->type == PHP_DRIVER_PREPARED_STATEMENT ? statement : NULL, arguments) ==
+          FAILURE) {
+    cass_statement_free(stmt);
+    return NULL;
+  }
+
+  return stmt;
+}
+
+void php_driver_bind_parameters_free(php_driver_bind_parameters* parameters) {
+  zend_hash_destroy(&parameters->names);
+  if (parameters->binders) efree(parameters->binders);
+  efree(parameters);
+}
@@ -221,6 +221,87 @@ int php_driver_validate_object(zval* object, zval* ztype) {
   }
 }
 
+zend_class_entry* php_driver_value_class(CassValueType type) {
+  switch (type) {
+    case CASS_VALUE_TYPE_FLOAT:
+      return php_driver_float_ce;
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_BIGINT:
+      return php_driver_bigint_ce;
+    case CASS_VALUE_TYPE_SMALL_INT:
+      return php_driver_smallint_ce;
+    case CASS_VALUE_TYPE_TINY_INT:
+      return php_driver_tinyint_ce;
+    case CASS_VALUE_TYPE_BLOB:
+      return php_driver_blob_ce;
+    case CASS_VALUE_TYPE_DECIMAL:
+      return php_driver_decimal_ce;
+    case CASS_VALUE_TYPE_DURATION:
+      return php_driver_duration_ce;
+    case CASS_VALUE_TYPE_TIMESTAMP:
+      return php_scylladb_timestamp_ce;
+    case CASS_VALUE_TYPE_DATE:
+      return php_scylladb_date_ce;
+    case CASS_VALUE_TYPE_TIME:
+      return php_scylladb_time_ce;
+    case CASS_VALUE_TYPE_UUID:
+      return php_driver_uuid_ce;
+    case CASS_VALUE_TYPE_VARINT:
+      return php_driver_varint_ce;
+    case CASS_VALUE_TYPE_TIMEUUID:
+      return php_driver_timeuuid_ce;
+    case CASS_VALUE_TYPE_INET:
+      return php_driver_inet_ce;
+    default:
+      return nullptr;
+  }
+}
+
+int php_driver_validate_array(HashTable* values, zval* ztype, const char* kind,
+                              const char* container) {
+  php_driver_type* type = PHP_DRIVER_GET_TYPE(ztype);
+  zend_class_entry* ce = php_driver_value_class(type->type);
+  zend_uchar expected = IS_UNDEF;
+  zval* object;
+
+  switch (type->type) {
+    case CASS_VALUE_TYPE_VARCHAR:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_ASCII:
+      expected = IS_STRING;
+      break;
+    case CASS_VALUE_TYPE_DOUBLE:
+      expected = IS_DOUBLE;
+      break;
+    case CASS_VALUE_TYPE_INT:
+      expected = IS_LONG;
+      break;
+    default:
+      break;
+  }
+
+  /* Elements of the expected PHP type or final value class are accepted
+   * without going through the generic validation */
+  ZEND_HASH_FOREACH_VAL(values, object) {
+    ZVAL_DEREF(object);
+
+    if (Z_TYPE_P(object) == expected ||
+        (ce && Z_TYPE_P(object) == IS_OBJECT && Z_OBJCE_P(object) == ce))
+      continue;
+
+    if (Z_TYPE_P(object) == IS_NULL) {
+      zend_throw_exception_ex(php_driver_invalid_argument_exception_ce, 0,
+                              "Invalid %s: null is not supported inside %s", kind, container);
+      return 0;
+    }
+
+    if (!php_driver_validate_object(object, ztype)) return 0;
+  }
+  ZEND_HASH_FOREACH_END();
+
+  return 1;
+}
+
 int php_driver_value_type(char* type, CassValueType* value_type) {
   if (strcmp("ascii", type) == 0) {
     *value_type = CASS_VALUE_TYPE_ASCII;
@@ -273,8 +354,7 @@ int php_driver_value_type(char* type, CassValueType* value_type) {
   return 1;
 }
 
-static int php_driver_collection_append(CassCollection* collection, zval* value,
-                                        CassValueType type) {
+int php_driver_collection_append(CassCollection* collection, zval* value, CassValueType type) {
   int result = 1;
   php_driver_blob* blob;
   php_driver_numeric* numeric;
@@ -693,13 +773,13 @@ int php_driver_collection_from_set(php_driver_set* set, CassCollection** collect
   CassCollection* collection = nullptr;
   php_driver_type* type;
   php_driver_type* value_type;
-  php_driver_set_entry *curr, *temp;
+  php_driver_flat_entry* curr;
 
   type = PHP_DRIVER_GET_TYPE(&set->type);
   value_type = PHP_DRIVER_GET_TYPE(&type->data.set.value_type);
-  collection = cass_collection_new_from_data_type(type->data_type, HASH_COUNT(set->entries));
-  HASH_ITER(hh, set->entries, curr, temp) {
-    if (!php_driver_collection_append(collection, &curr->value, value_type->type)) {
+  collection = cass_collection_new_from_data_type(type->data_type, set->entries.count);
+  PHP_DRIVER_FLAT_HASH_FOREACH(&set->entries, curr) {
+    if (!php_driver_collection_append(collection, &curr->key, value_type->type)) {
       result = 0;
       break;
     }
@@ -749,13 +829,13 @@ int php_driver_collection_from_map(php_driver_map* map, CassCollection** collect
   php_driver_type* type;
   php_driver_type* key_type;
   php_driver_type* value_type;
-  php_driver_map_entry *curr, *temp;
+  php_driver_flat_entry* curr;
 
   type = PHP_DRIVER_GET_TYPE(&(map->type));
   value_type = PHP_DRIVER_GET_TYPE(&(type->data.map.value_type));
   key_type = PHP_DRIVER_GET_TYPE(&(type->data.map.key_type));
-  collection = cass_collection_new_from_data_type(type->data_type, HASH_COUNT(map->entries));
-  HASH_ITER(hh, map->entries, curr, temp) {
+  collection = cass_collection_new_from_data_type(type->data_type, map->entries.count);
+  PHP_DRIVER_FLAT_HASH_FOREACH(&map->entries, curr) {
     if (!php_driver_collection_append(collection, &(curr->key), key_type->type)) {
       result = 0;
       break;
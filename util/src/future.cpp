@@ -14,10 +14,57 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+
 #include <php_driver.h>
+#include <php_driver_globals.h>
 #include <php_driver_types.h>
 
 #include <util/future.h>
+#include <util/ref.h>
+
+/* References are only released from the request's thread, driver callbacks
+ * can't be used for them.
+ */
+typedef struct php_driver_pending_release_ {
+  CassFuture* future;
+  php_driver_ref* statement;
+  struct php_driver_pending_release_* next;
+} php_driver_pending_release;
+
+/* Counters and states are released from driver threads as well, so they
+ * aren't allocated with emalloc()
+ */
+struct php_driver_future_counter_ {
+  std::atomic<int> refs;
+  std::atomic<cass_int64_t> in_flight;
+};
+
+struct php_driver_future_state_ {
+  std::atomic<int> refs;
+  std::mutex mutex;
+  bool done;
+  std::vector<php_driver_future_queue*> queues;
+  php_driver_future_counter* counter;
+};
+
+/* Converts a timeout in seconds to microseconds, a missing timeout is 0 */
+int
+php_driver_future_parse_timeout(zval* timeout, cass_duration_t* timeout_us)
+{
+  if (timeout == NULL || Z_TYPE_P(timeout) == IS_NULL || Z_TYPE_P(timeout) == IS_UNDEF) {
+    *timeout_us = 0;
+  } else if ((Z_TYPE_P(timeout) == IS_LONG && Z_LVAL_P(timeout) > 0)) {
+    *timeout_us = Z_LVAL_P(timeout) * 1000000;
+  } else if ((Z_TYPE_P(timeout) == IS_DOUBLE && Z_DVAL_P(timeout) > 0)) {
+    *timeout_us = ceil(Z_DVAL_P(timeout) * 1000000);
+  } else {
+    INVALID_ARGUMENT_VALUE(timeout, "an positive number of seconds or null", FAILURE);
+  }
+
+  return SUCCESS;
+}
 
 int
 php_driver_future_wait_timed(CassFuture* future, zval* timeout)
@@ -27,19 +74,14 @@ php_driver_future_wait_timed(CassFuture* future, zval* timeout)
   if (cass_future_ready(future))
     return SUCCESS;
 
-  if (timeout == NULL || Z_TYPE_P(timeout) == IS_NULL || Z_TYPE_P(timeout) == IS_UNDEF) {
+  if (php_driver_future_parse_timeout(timeout, &timeout_us) == FAILURE)
+    return FAILURE;
+
+  if (timeout_us == 0) {
     cass_future_wait(future);
     return SUCCESS;
   }
 
-  if ((Z_TYPE_P(timeout) == IS_LONG && Z_LVAL_P(timeout) > 0)) {
-    timeout_us = Z_LVAL_P(timeout) * 1000000;
-  } else if ((Z_TYPE_P(timeout) == IS_DOUBLE && Z_DVAL_P(timeout) > 0)) {
-    timeout_us = ceil(Z_DVAL_P(timeout) * 1000000);
-  } else {
-    INVALID_ARGUMENT_VALUE(timeout, "an positive number of seconds or null", FAILURE);
-  }
-
   if (!cass_future_wait_timed(future, timeout_us)) {
     zend_throw_exception_ex(php_driver_timeout_exception_ce, 0,
                             "Future hasn't resolved within %f seconds", timeout_us / 1000000.0);
@@ -49,6 +91,20 @@ php_driver_future_wait_timed(CassFuture* future, zval* timeout)
   return SUCCESS;
 }
 
+cass_duration_t
+php_driver_future_time_left(cass_duration_t timeout_us, std::chrono::steady_clock::time_point start)
+{
+  cass_duration_t elapsed;
+
+  if (timeout_us == 0)
+    return 0;
+
+  elapsed = (cass_duration_t) std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+
+  return elapsed < timeout_us ? timeout_us - elapsed : 1;
+}
+
 int
 php_driver_future_is_error(CassFuture* future)
 {
@@ -63,3 +119,186 @@ php_driver_future_is_error(CassFuture* future)
   }
   return SUCCESS;
 }
+
+php_driver_future_counter*
+php_driver_future_counter_new()
+{
+  php_driver_future_counter* counter = new php_driver_future_counter();
+
+  counter->refs      = 1;
+  counter->in_flight = 0;
+  return counter;
+}
+
+php_driver_future_counter*
+php_driver_future_counter_add_ref(php_driver_future_counter* counter)
+{
+  if (counter)
+    counter->refs++;
+  return counter;
+}
+
+void
+php_driver_future_counter_release(php_driver_future_counter** counter)
+{
+  if (*counter && --(*counter)->refs == 0)
+    delete *counter;
+  *counter = NULL;
+}
+
+cass_int64_t
+php_driver_future_counter_in_flight(php_driver_future_counter* counter)
+{
+  return counter->in_flight.load();
+}
+
+php_driver_future_counter*
+php_driver_future_counter_start(php_driver_future_counter* counter)
+{
+  if (counter)
+    counter->in_flight++;
+  return php_driver_future_counter_add_ref(counter);
+}
+
+void
+php_driver_future_counter_done(php_driver_future_counter** counter)
+{
+  if (*counter)
+    (*counter)->in_flight--;
+  php_driver_future_counter_release(counter);
+}
+
+void
+php_driver_future_state_release(php_driver_future_state** state)
+{
+  if (*state && --(*state)->refs == 0)
+    delete *state;
+  *state = NULL;
+}
+
+/* Queues are locked after the state, see php_driver_future_queue_watch() */
+static void
+php_driver_future_complete(CassFuture* future, php_driver_future_state* state)
+{
+  std::lock_guard<std::mutex> lock(state->mutex);
+
+  state->done = true;
+  for (php_driver_future_queue* queue : state->queues) {
+    std::lock_guard<std::mutex> queue_lock(queue->mutex);
+    queue->completed.push_back(future);
+    queue->ready.notify_one();
+  }
+  state->queues.clear();
+}
+
+static void
+php_driver_future_done(CassFuture* future, void* data)
+{
+  php_driver_future_state* state = (php_driver_future_state*) data;
+
+  php_driver_future_counter_done(&state->counter);
+  php_driver_future_complete(future, state);
+  php_driver_future_state_release(&state);
+}
+
+php_driver_future_state*
+php_driver_future_track(CassFuture* future, php_driver_future_counter* counter)
+{
+  php_driver_future_state* state = new php_driver_future_state();
+
+  /* One reference for the owner of the future, one for its callback */
+  state->refs    = 2;
+  state->done    = false;
+  state->counter = php_driver_future_counter_start(counter);
+
+  if (cass_future_set_callback(future, php_driver_future_done, state) != CASS_OK) {
+    cass_future_wait(future);
+    php_driver_future_done(future, state);
+  }
+
+  return state;
+}
+
+void
+php_driver_future_count(CassFuture* future, php_driver_future_counter* counter)
+{
+  php_driver_future_state* state = php_driver_future_track(future, counter);
+  php_driver_future_state_release(&state);
+}
+
+void
+php_driver_future_queue_watch(php_driver_future_queue* queue, php_driver_future_state* state)
+{
+  std::lock_guard<std::mutex> lock(state->mutex);
+
+  state->refs++;
+  queue->watched.push_back(state);
+
+  /* A future whose callback has run is ready, callers take those without waiting */
+  if (!state->done)
+    state->queues.push_back(queue);
+}
+
+void
+php_driver_future_queue_close(php_driver_future_queue* queue)
+{
+  for (php_driver_future_state* state : queue->watched) {
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->queues.erase(std::remove(state->queues.begin(), state->queues.end(), queue),
+                          state->queues.end());
+    }
+    php_driver_future_state_release(&state);
+  }
+  queue->watched.clear();
+}
+
+CassFuture*
+php_driver_future_queue_next(php_driver_future_queue* queue, cass_duration_t timeout_us)
+{
+  CassFuture* future;
+  std::unique_lock<std::mutex> lock(queue->mutex);
+  auto completed = [queue] { return !queue->completed.empty(); };
+
+  if (timeout_us == 0)
+    queue->ready.wait(lock, completed);
+  else if (!queue->ready.wait_for(lock, std::chrono::microseconds(timeout_us), completed))
+    return NULL;
+
+  future = queue->completed.front();
+  queue->completed.pop_front();
+  return future;
+}
+
+void
+php_driver_future_release_later(CassFuture* future, php_driver_ref* statement)
+{
+  php_driver_pending_release* pending =
+      (php_driver_pending_release*) emalloc(sizeof(php_driver_pending_release));
+
+  pending->future    = future;
+  pending->statement = statement;
+  pending->next      = PHP_DRIVER_G(pending_releases);
+  PHP_DRIVER_G(pending_releases) = pending;
+}
+
+void
+php_driver_future_release_completed(zend_bool all)
+{
+  php_driver_pending_release** link = &PHP_DRIVER_G(pending_releases);
+
+  /* The driver holds its own reference to the requests it sends */
+  while (*link) {
+    php_driver_pending_release* pending = *link;
+
+    if (!all && !cass_future_ready(pending->future)) {
+      link = &pending->next;
+      continue;
+    }
+
+    *link = pending->next;
+    cass_future_free(pending->future);
+    php_driver_del_ref(&pending->statement);
+    efree(pending);
+  }
+}
@@ -98,6 +98,8 @@ php_driver_value_compare(zval* zvalue1, zval* zvalue2)
   case IS_STRING:
     return zend_binary_zval_strcmp(zvalue1, zvalue2);
   case IS_OBJECT:
+    if (Z_OBJ_P(zvalue1) == Z_OBJ_P(zvalue2))
+      return 0;
     return Z_OBJ_P(zvalue1)->handlers->compare(zvalue1, zvalue2);
   default:
     return 1;
@@ -132,3 +134,274 @@ php_driver_mpz_hash(uint32_t seed, mpz_t n)
 #endif
   return hashv;
 }
+
+zend_ulong
+php_driver_value_version(zval* value)
+{
+  zend_class_entry* ce = Z_OBJCE_P(value);
+
+  if (ce == php_driver_collection_ce)
+    return PHP_DRIVER_GET_COLLECTION(value)->version;
+  if (ce == php_driver_map_ce)
+    return PHP_DRIVER_GET_MAP(value)->version;
+  if (ce == php_driver_set_ce)
+    return PHP_DRIVER_GET_SET(value)->version;
+  if (ce == php_driver_tuple_ce)
+    return PHP_DRIVER_GET_TUPLE(value)->version;
+  return PHP_DRIVER_GET_USER_TYPE_VALUE(value)->version;
+}
+
+/* Whether the hash cached by a nested value still holds, without computing it */
+zend_bool
+php_driver_value_hash_cached(zval* value)
+{
+  zend_class_entry* ce = Z_OBJCE_P(value);
+
+  if (ce == php_driver_collection_ce) {
+    php_driver_collection* collection = PHP_DRIVER_GET_COLLECTION(value);
+    return PHP_DRIVER_HASH_CACHED(collection,
+                                  php_driver_nested_hash_cached(&collection->values, collection->hash_version));
+  }
+  if (ce == php_driver_map_ce) {
+    php_driver_map* map = PHP_DRIVER_GET_MAP(value);
+    return PHP_DRIVER_HASH_CACHED(map, php_driver_flat_nested_hash_cached(&map->entries, map->hash_version));
+  }
+  if (ce == php_driver_set_ce) {
+    php_driver_set* set = PHP_DRIVER_GET_SET(value);
+    return PHP_DRIVER_HASH_CACHED(set, 0);
+  }
+  if (ce == php_driver_tuple_ce) {
+    php_driver_tuple* tuple = PHP_DRIVER_GET_TUPLE(value);
+    return PHP_DRIVER_HASH_CACHED(tuple, php_driver_nested_hash_cached(&tuple->values, tuple->hash_version));
+  }
+
+  php_driver_user_type_value* user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(value);
+  return PHP_DRIVER_HASH_CACHED(user_type_value,
+                                php_driver_nested_hash_cached(&user_type_value->values,
+                                                              user_type_value->hash_version));
+}
+
+/* Nested values are unchanged when none of them has been mutated since their
+ * versions summed to version, and none of the values they hold either */
+zend_bool
+php_driver_nested_hash_cached(HashTable* values, zend_ulong version)
+{
+  zval* current;
+  zend_ulong sum = 0;
+
+  ZEND_HASH_FOREACH_VAL(values, current) {
+    if (!php_driver_value_is_nested(current))
+      continue;
+    if (!php_driver_value_hash_cached(current))
+      return 0;
+    sum += php_driver_value_version(current);
+  } ZEND_HASH_FOREACH_END();
+
+  return sum == version;
+}
+
+zend_bool
+php_driver_flat_nested_hash_cached(php_driver_flat_hash* table, zend_ulong version)
+{
+  php_driver_flat_entry* curr;
+  zend_ulong sum = 0;
+
+  PHP_DRIVER_FLAT_HASH_FOREACH(table, curr) {
+    if (!php_driver_value_is_nested(&curr->value))
+      continue;
+    if (!php_driver_value_hash_cached(&curr->value))
+      return 0;
+    sum += php_driver_value_version(&curr->value);
+  }
+
+  return sum == version;
+}
+
+#define PHP_DRIVER_FLAT_HASH_MIN_SIZE 8
+
+/* Compacts removed entries out while moving the entries to a table of the
+ * given size. The position of an iterator, when given, is moved along with
+ * its entry. */
+static void
+php_driver_flat_hash_resize(php_driver_flat_hash* table, uint32_t size, uint32_t* pos)
+{
+  /* Entries and index share a single allocation, the index having twice as
+   * many slots as there are entries keeps the load factor under one half. */
+  php_driver_flat_entry* entries =
+    (php_driver_flat_entry*) emalloc(size * sizeof(php_driver_flat_entry) +
+                                     2 * size * sizeof(uint32_t));
+  uint32_t* index = (uint32_t*) (entries + size);
+  uint32_t mask   = 2 * size - 1;
+  uint32_t used   = 0;
+  uint32_t count  = 0;
+  uint32_t moved  = 0;
+  uint32_t i;
+
+  memset(index, 0, 2 * size * sizeof(uint32_t));
+
+  for (i = 0; i < table->used; ++i) {
+    php_driver_flat_entry* entry = &table->entries[i];
+    uint32_t slot;
+
+    if (pos && i == *pos) {
+      moved = used;
+
+      /* A removed entry under the iterator stays, unindexed, so that moving
+       * past it still lands on the entry that followed it */
+      if (Z_ISUNDEF(entry->key)) {
+        entries[used++] = *entry;
+        continue;
+      }
+    }
+
+    if (Z_ISUNDEF(entry->key))
+      continue;
+
+    entries[used] = *entry;
+    for (slot = entry->hash & mask; index[slot] != 0; slot = (slot + 1) & mask)
+      ;
+    index[slot] = ++used;
+    count++;
+  }
+
+  if (pos)
+    *pos = *pos < table->used ? moved : used;
+
+  if (table->entries)
+    efree(table->entries);
+
+  table->entries = entries;
+  table->index   = index;
+  table->used    = used;
+  table->count   = count;
+  table->size    = size;
+}
+
+php_driver_flat_entry*
+php_driver_flat_hash_find_hash(php_driver_flat_hash* table, zval* key, uint32_t hash)
+{
+  uint32_t mask, slot;
+
+  if (table->size == 0)
+    return NULL;
+
+  mask = 2 * table->size - 1;
+  for (slot = hash & mask; table->index[slot] != 0; slot = (slot + 1) & mask) {
+    php_driver_flat_entry* entry = &table->entries[table->index[slot] - 1];
+    /* Only entries with the same cached hash need a full comparison */
+    if (entry->hash == hash && !Z_ISUNDEF(entry->key) &&
+        php_driver_value_compare(&entry->key, key) == 0)
+      return entry;
+  }
+
+  return NULL;
+}
+
+void
+php_driver_flat_hash_init(php_driver_flat_hash* table)
+{
+  table->entries = NULL;
+  table->index   = NULL;
+  table->used    = 0;
+  table->count   = 0;
+  table->size    = 0;
+}
+
+void
+php_driver_flat_hash_destroy(php_driver_flat_hash* table)
+{
+  php_driver_flat_entry* entry;
+
+  PHP_DRIVER_FLAT_HASH_FOREACH(table, entry)
+  {
+    zval_ptr_dtor(&entry->key);
+    zval_ptr_dtor(&entry->value);
+  }
+
+  if (table->entries)
+    efree(table->entries);
+
+  php_driver_flat_hash_init(table);
+}
+
+void
+php_driver_flat_hash_reserve(php_driver_flat_hash* table, uint32_t size)
+{
+  uint32_t new_size = PHP_DRIVER_FLAT_HASH_MIN_SIZE;
+
+  if (size <= table->size)
+    return;
+
+  while (new_size < size)
+    new_size <<= 1;
+
+  php_driver_flat_hash_resize(table, new_size, NULL);
+}
+
+php_driver_flat_entry*
+php_driver_flat_hash_find(php_driver_flat_hash* table, zval* key)
+{
+  return php_driver_flat_hash_find_hash(table, key, php_driver_value_hash(key));
+}
+
+php_driver_flat_entry*
+php_driver_flat_hash_add(php_driver_flat_hash* table, zval* key, zend_bool* added, uint32_t* pos)
+{
+  uint32_t hash = php_driver_value_hash(key);
+  php_driver_flat_entry* entry = php_driver_flat_hash_find_hash(table, key, hash);
+  uint32_t mask, slot;
+
+  if (added)
+    *added = entry == NULL;
+
+  if (entry)
+    return entry;
+
+  if (table->used == table->size) {
+    /* Reclaim removed entries in place when they make up half of the table */
+    if (table->size == 0)
+      php_driver_flat_hash_resize(table, PHP_DRIVER_FLAT_HASH_MIN_SIZE, pos);
+    else
+      php_driver_flat_hash_resize(table, table->count < table->size / 2 ? table->size : 2 * table->size,
+                                  pos);
+  }
+
+  entry = &table->entries[table->used];
+  ZVAL_COPY(&entry->key, key);
+  ZVAL_UNDEF(&entry->value);
+  entry->hash = hash;
+
+  mask = 2 * table->size - 1;
+  for (slot = hash & mask; table->index[slot] != 0; slot = (slot + 1) & mask)
+    ;
+  table->index[slot] = ++table->used;
+  table->count++;
+
+  return entry;
+}
+
+int
+php_driver_flat_hash_del(php_driver_flat_hash* table, zval* key)
+{
+  php_driver_flat_entry* entry = php_driver_flat_hash_find(table, key);
+
+  if (entry == NULL)
+    return 0;
+
+  /* The slot keeps pointing at the removed entry so that probing continues past it */
+  zval_ptr_dtor(&entry->key);
+  zval_ptr_dtor(&entry->value);
+  ZVAL_UNDEF(&entry->key);
+  ZVAL_UNDEF(&entry->value);
+  table->count--;
+
+  return 1;
+}
+
+uint32_t
+php_driver_flat_hash_next(php_driver_flat_hash* table, uint32_t pos)
+{
+  while (pos < table->used && Z_ISUNDEF(table->entries[pos].key))
+    pos++;
+  return pos;
+}
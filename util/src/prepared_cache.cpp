@@ -0,0 +1,163 @@
+/**
+ * Copyright 2015-2017 DataStax, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <php_driver.h>
+#include <php_driver_types.h>
+
+#include <util/prepared_cache.h>
+
+static zend_always_inline zend_ulong
+php_driver_prepared_cache_combine(zend_ulong seed, zend_ulong value)
+{
+  seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  return seed;
+}
+
+static void
+php_driver_prepared_cache_unlink(php_driver_prepared_cache* cache,
+                                 php_driver_prepared_cache_entry* entry)
+{
+  if (entry->prev)
+    entry->prev->next = entry->next;
+  else
+    cache->head = entry->next;
+
+  if (entry->next)
+    entry->next->prev = entry->prev;
+  else
+    cache->tail = entry->prev;
+
+  entry->prev = entry->next = NULL;
+}
+
+static void
+php_driver_prepared_cache_link(php_driver_prepared_cache* cache,
+                               php_driver_prepared_cache_entry* entry)
+{
+  entry->prev = NULL;
+  entry->next = cache->head;
+
+  if (cache->head)
+    cache->head->prev = entry;
+  else
+    cache->tail = entry;
+
+  cache->head = entry;
+}
+
+static void
+php_driver_prepared_cache_remove(php_driver_prepared_cache* cache,
+                                 php_driver_prepared_cache_entry* entry)
+{
+  php_driver_prepared_cache_unlink(cache, entry);
+  zend_hash_index_del(&cache->entries, entry->hash);
+
+  cass_future_free(entry->future);
+  zend_string_release(entry->cql);
+  pefree(entry, 1);
+}
+
+php_driver_prepared_cache*
+php_driver_prepared_cache_new()
+{
+  php_driver_prepared_cache* cache =
+      (php_driver_prepared_cache*) pecalloc(1, sizeof(php_driver_prepared_cache), 1);
+
+  zend_hash_init(&cache->entries, 0, NULL, NULL, 1);
+
+  return cache;
+}
+
+void
+php_driver_prepared_cache_free(php_driver_prepared_cache* cache)
+{
+  php_driver_prepared_cache_trim(cache, 0);
+  zend_hash_destroy(&cache->entries);
+  pefree(cache, 1);
+}
+
+zend_ulong
+php_driver_prepared_cache_scope(const char* hash_key, size_t hash_key_len)
+{
+  return zend_inline_hash_func(hash_key, hash_key_len);
+}
+
+zend_ulong
+php_driver_prepared_cache_hash(zend_ulong scope, zend_string* cql)
+{
+  /* The hash of interned and previously hashed strings is already stored on them */
+  return php_driver_prepared_cache_combine(scope, zend_string_hash_val(cql));
+}
+
+CassFuture*
+php_driver_prepared_cache_find(php_driver_prepared_cache* cache, zend_ulong hash,
+                               zend_ulong scope, zend_string* cql)
+{
+  php_driver_prepared_cache_entry* entry =
+      (php_driver_prepared_cache_entry*) zend_hash_index_find_ptr(&cache->entries, hash);
+
+  if (!entry || entry->scope != scope || !zend_string_equals(entry->cql, cql)) {
+    cache->misses++;
+    return NULL;
+  }
+
+  if (entry != cache->head) {
+    php_driver_prepared_cache_unlink(cache, entry);
+    php_driver_prepared_cache_link(cache, entry);
+  }
+
+  cache->hits++;
+  return entry->future;
+}
+
+int
+php_driver_prepared_cache_add(php_driver_prepared_cache* cache, zend_ulong hash,
+                              zend_ulong scope, zend_string* cql, CassFuture* future,
+                              zend_long capacity)
+{
+  php_driver_prepared_cache_entry* entry;
+
+  if (capacity <= 0)
+    return FAILURE;
+
+  /* A statement colliding on the hash replaces the previous one */
+  entry = (php_driver_prepared_cache_entry*) zend_hash_index_find_ptr(&cache->entries, hash);
+  if (entry)
+    php_driver_prepared_cache_remove(cache, entry);
+
+  php_driver_prepared_cache_trim(cache, capacity - 1);
+
+  entry = (php_driver_prepared_cache_entry*)
+      pecalloc(1, sizeof(php_driver_prepared_cache_entry), 1);
+  entry->hash   = hash;
+  entry->scope  = scope;
+  entry->cql    = zend_string_init(ZSTR_VAL(cql), ZSTR_LEN(cql), 1);
+  entry->future = future;
+
+  zend_hash_index_add_new_ptr(&cache->entries, hash, entry);
+  php_driver_prepared_cache_link(cache, entry);
+
+  return SUCCESS;
+}
+
+void
+php_driver_prepared_cache_trim(php_driver_prepared_cache* cache, zend_long capacity)
+{
+  while (cache->tail && (zend_long) zend_hash_num_elements(&cache->entries) > MAX(capacity, 0)) {
+    php_driver_prepared_cache_remove(cache, cache->tail);
+    cache->evictions++;
+  }
+}
@@ -16,7 +16,9 @@
 
 #include <php_driver.h>
 #include <php_driver_types.h>
+#include <util/hash.h>
 #include <util/math.h>
+#include <util/ref.h>
 #include <util/result.h>
 #include <util/types.h>
 
@@ -27,444 +29,976 @@
 #include "src/Tuple.h"
 #include "src/UserTypeValue.h"
 
-int php_driver_value(const CassValue *value, const CassDataType *data_type, zval *out)
+int php_driver_get_keyspace_field(const CassKeyspaceMeta *metadata, const char *field_name, zval *out)
+{
+    const CassValue *value;
+
+    value = cass_keyspace_meta_field_by_name(metadata, field_name);
+
+    if (value == NULL || cass_value_is_null(value))
+    {
+
+        ZVAL_NULL(out);
+        return SUCCESS;
+    }
+
+    return php_driver_value(value, cass_value_data_type(value), out);
+}
+
+int php_driver_get_table_field(const CassTableMeta *metadata, const char *field_name, zval *out)
+{
+    const CassValue *value;
+
+    value = cass_table_meta_field_by_name(metadata, field_name);
+
+    if (value == NULL || cass_value_is_null(value))
+    {
+
+        ZVAL_NULL(out);
+        return SUCCESS;
+    }
+
+    return php_driver_value(value, cass_value_data_type(value), out);
+}
+
+int php_driver_get_column_field(const CassColumnMeta *metadata, const char *field_name, zval *out)
+{
+    const CassValue *value;
+
+    value = cass_column_meta_field_by_name(metadata, field_name);
+
+    if (value == NULL || cass_value_is_null(value))
+    {
+
+        ZVAL_NULL(out);
+        return SUCCESS;
+    }
+
+    return php_driver_value(value, cass_value_data_type(value), out);
+}
+
+/* Decoders selected by the native execution options */
+#define PHP_DRIVER_DECODE_NATIVE_BLOB (1 << 0)
+#define PHP_DRIVER_DECODE_NATIVE_UUID (1 << 1)
+#define PHP_DRIVER_DECODE_NATIVE_BIGINT (1 << 2)
+#define PHP_DRIVER_DECODE_NATIVE_SMALLINT (1 << 3)
+
+/* Smaller blobs are copied so that they don't keep a whole result page alive */
+#define PHP_DRIVER_BLOB_BORROW_MIN_SIZE 4096
+
+#define DECODE_ASSERT_SUCCESS(rc) ASSERT_SUCCESS_BLOCK(rc, zval_ptr_dtor(out); ZVAL_UNDEF(out); return FAILURE;)
+
+static zend_always_inline int php_driver_decode(const php_driver_decoder *decoder, const CassValue *value,
+                                                php_driver_ref *result, zval *out)
+{
+    if (cass_value_is_null(value))
+    {
+        ZVAL_NULL(out);
+        return SUCCESS;
+    }
+
+    return decoder->decode(decoder, value, result, out);
+}
+
+static int decode_value(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                        zval *out)
+{
+    /* Columns without metadata are decoded using the type carried by the value */
+    return php_driver_value(value, cass_value_data_type(value), out);
+}
+
+static int decode_null(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    ZVAL_NULL(out);
+    return SUCCESS;
+}
+
+static int decode_string(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                         zval *out)
 {
     const char *v_string;
     size_t v_string_len;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_string(value, &v_string, &v_string_len), FAILURE);
+    ZVAL_STRINGL(out, v_string, v_string_len);
+    return SUCCESS;
+}
+
+static int decode_int(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                      zval *out)
+{
+    cass_int32_t v_int_32;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_int32(value, &v_int_32), FAILURE);
+    ZVAL_LONG(out, v_int_32);
+    return SUCCESS;
+}
+
+static int decode_boolean(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                          zval *out)
+{
+    cass_bool_t v_boolean;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_bool(value, &v_boolean), FAILURE);
+    ZVAL_BOOL(out, v_boolean);
+    return SUCCESS;
+}
+
+static int decode_double(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                         zval *out)
+{
+    cass_double_t v_double;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_double(value, &v_double), FAILURE);
+    ZVAL_DOUBLE(out, v_double);
+    return SUCCESS;
+}
+
+static int decode_bigint(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                         zval *out)
+{
+    object_init_ex(out, php_driver_bigint_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_int64(value, &PHP_DRIVER_GET_NUMERIC(out)->data.bigint.value));
+    return SUCCESS;
+}
+
+static int decode_smallint(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                           zval *out)
+{
+    object_init_ex(out, php_driver_smallint_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_int16(value, &PHP_DRIVER_GET_NUMERIC(out)->data.smallint.value));
+    return SUCCESS;
+}
+
+static int decode_tinyint(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                          zval *out)
+{
+    object_init_ex(out, php_driver_tinyint_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_int8(value, &PHP_DRIVER_GET_NUMERIC(out)->data.tinyint.value));
+    return SUCCESS;
+}
+
+static int decode_float(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                        zval *out)
+{
+    object_init_ex(out, php_driver_float_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_float(value, &PHP_DRIVER_GET_NUMERIC(out)->data.floating.value));
+    return SUCCESS;
+}
+
+static int decode_timestamp(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                            zval *out)
+{
+    object_init_ex(out, php_scylladb_timestamp_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_int64(value, &Z_SCYLLADB_TIMESTAMP_P(out)->timestamp));
+    return SUCCESS;
+}
+
+static int decode_date(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    object_init_ex(out, php_scylladb_date_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_uint32(value, &Z_SCYLLADB_DATE_P(out)->date));
+    return SUCCESS;
+}
+
+static int decode_time(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    object_init_ex(out, php_scylladb_time_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_int64(value, &Z_SCYLLADB_TIME_P(out)->time));
+    return SUCCESS;
+}
+
+static int decode_blob(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    const cass_byte_t *v_bytes;
+    size_t v_bytes_len;
+    php_driver_blob *blob;
+
+    object_init_ex(out, php_driver_blob_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_bytes(value, &v_bytes, &v_bytes_len));
+    blob = PHP_DRIVER_GET_BLOB(out);
+    blob->size = v_bytes_len;
+
+    if (result && v_bytes_len >= PHP_DRIVER_BLOB_BORROW_MIN_SIZE)
+    {
+        /* Borrow the bytes from the result buffer, the blob keeps the result alive */
+        blob->data = (cass_byte_t *)v_bytes;
+        blob->ref = php_driver_add_ref(result);
+    }
+    else
+    {
+        blob->data = static_cast<cass_byte_t *>(emalloc(v_bytes_len * sizeof(cass_byte_t)));
+        memcpy(blob->data, v_bytes, v_bytes_len);
+    }
+    return SUCCESS;
+}
+
+static int decode_varint(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                         zval *out)
+{
     const cass_byte_t *v_bytes;
     size_t v_bytes_len;
+
+    object_init_ex(out, php_driver_varint_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_bytes(value, &v_bytes, &v_bytes_len));
+    import_twos_complement((cass_byte_t *)v_bytes, v_bytes_len, &PHP_DRIVER_GET_NUMERIC(out)->data.varint.value);
+    return SUCCESS;
+}
+
+static int decode_decimal(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                          zval *out)
+{
     const cass_byte_t *v_decimal;
     size_t v_decimal_len;
     cass_int32_t v_decimal_scale;
-    cass_int32_t v_int_32;
-    cass_bool_t v_boolean;
-    cass_double_t v_double;
-    php_driver_uuid *uuid;
+    php_driver_numeric *numeric;
+
+    object_init_ex(out, php_driver_decimal_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_decimal(value, &v_decimal, &v_decimal_len, &v_decimal_scale));
+    numeric = PHP_DRIVER_GET_NUMERIC(out);
+    import_twos_complement((cass_byte_t *)v_decimal, v_decimal_len, &numeric->data.decimal.value);
+    numeric->data.decimal.scale = v_decimal_scale;
+    return SUCCESS;
+}
+
+static int decode_uuid(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    object_init_ex(out, decoder->value_type == CASS_VALUE_TYPE_TIMEUUID ? php_driver_timeuuid_ce : php_driver_uuid_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_uuid(value, &PHP_DRIVER_GET_UUID(out)->uuid));
+    return SUCCESS;
+}
+
+static int decode_inet(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    object_init_ex(out, php_driver_inet_ce);
+    DECODE_ASSERT_SUCCESS(cass_value_get_inet(value, &PHP_DRIVER_GET_INET(out)->inet));
+    return SUCCESS;
+}
+
+static int decode_duration(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                           zval *out)
+{
+    php_driver_duration *duration;
+
+    object_init_ex(out, php_driver_duration_ce);
+    duration = PHP_DRIVER_GET_DURATION(out);
+    DECODE_ASSERT_SUCCESS(cass_value_get_duration(value, &duration->months, &duration->days, &duration->nanos));
+    return SUCCESS;
+}
+
+static int decode_list(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                       zval *out)
+{
+    php_driver_collection *collection;
     CassIterator *iterator;
-    php_driver_numeric *numeric = NULL;
-    php_scylladb_timestamp *timestamp = NULL;
-    php_scylladb_date *date = NULL;
-    php_scylladb_time *time = NULL;
-    php_driver_blob *blob = NULL;
-    php_driver_inet *inet = NULL;
-    php_driver_duration *duration = NULL;
-    php_driver_collection *collection = NULL;
-    php_driver_map *map = NULL;
-    php_driver_set *set = NULL;
-    php_driver_tuple *tuple = NULL;
-    php_driver_user_type_value *user_type_value = NULL;
-    ulong index;
-
-    CassValueType type = cass_data_type_type(data_type);
-    const CassDataType *primary_type;
-    const CassDataType *secondary_type;
 
+    object_init_ex(out, php_driver_collection_ce);
+    collection = PHP_DRIVER_GET_COLLECTION(out);
+    ZVAL_COPY(&collection->type, &decoder->type);
 
+    iterator = cass_iterator_from_collection(value);
 
-    if (cass_value_is_null(value))
+    while (cass_iterator_next(iterator))
     {
-        ZVAL_NULL(out);
-        return SUCCESS;
+        zval v;
+
+        if (php_driver_decode(&decoder->sub[0], cass_iterator_get_value(iterator), result, &v) == FAILURE)
+        {
+            cass_iterator_free(iterator);
+            zval_ptr_dtor(out);
+            return FAILURE;
+        }
+
+        php_driver_collection_add(collection, &v);
+        zval_ptr_dtor(&v);
+    }
+
+    cass_iterator_free(iterator);
+    return SUCCESS;
+}
+
+static int decode_set(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                      zval *out)
+{
+    php_driver_set *set;
+    CassIterator *iterator;
+
+    object_init_ex(out, php_driver_set_ce);
+    set = PHP_DRIVER_GET_SET(out);
+    ZVAL_COPY(&set->type, &decoder->type);
+    php_driver_flat_hash_reserve(&set->entries, (uint32_t)cass_value_item_count(value));
+
+    iterator = cass_iterator_from_collection(value);
+
+    while (cass_iterator_next(iterator))
+    {
+        zval v;
+
+        if (php_driver_decode(&decoder->sub[0], cass_iterator_get_value(iterator), result, &v) == FAILURE)
+        {
+            cass_iterator_free(iterator);
+            zval_ptr_dtor(out);
+            return FAILURE;
+        }
+
+        php_driver_set_add(set, &v);
+        zval_ptr_dtor(&v);
+    }
+
+    cass_iterator_free(iterator);
+    return SUCCESS;
+}
+
+static int decode_map(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                      zval *out)
+{
+    php_driver_map *map;
+    CassIterator *iterator;
+
+    object_init_ex(out, php_driver_map_ce);
+    map = PHP_DRIVER_GET_MAP(out);
+    ZVAL_COPY(&map->type, &decoder->type);
+    php_driver_flat_hash_reserve(&map->entries, (uint32_t)cass_value_item_count(value));
+
+    iterator = cass_iterator_from_map(value);
+
+    while (cass_iterator_next(iterator))
+    {
+        zval k;
+        zval v;
+
+        if (php_driver_decode(&decoder->sub[0], cass_iterator_get_map_key(iterator), result, &k) == FAILURE)
+        {
+            cass_iterator_free(iterator);
+            zval_ptr_dtor(out);
+            return FAILURE;
+        }
+
+        if (php_driver_decode(&decoder->sub[1], cass_iterator_get_map_value(iterator), result, &v) == FAILURE)
+        {
+            zval_ptr_dtor(&k);
+            cass_iterator_free(iterator);
+            zval_ptr_dtor(out);
+            return FAILURE;
+        }
+
+        php_driver_map_set(map, &k, &v);
+        zval_ptr_dtor(&k);
+        zval_ptr_dtor(&v);
+    }
+
+    cass_iterator_free(iterator);
+    return SUCCESS;
+}
+
+static int decode_tuple(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                        zval *out)
+{
+    php_driver_tuple *tuple;
+    CassIterator *iterator;
+    size_t index = 0;
+
+    object_init_ex(out, php_driver_tuple_ce);
+    tuple = PHP_DRIVER_GET_TUPLE(out);
+    ZVAL_COPY(&tuple->type, &decoder->type);
+
+    iterator = cass_iterator_from_tuple(value);
+
+    while (cass_iterator_next(iterator) && index < decoder->count)
+    {
+        const CassValue *item = cass_iterator_get_value(iterator);
+
+        if (!cass_value_is_null(item))
+        {
+            zval v;
+
+            if (decoder->sub[index].decode(&decoder->sub[index], item, result, &v) == FAILURE)
+            {
+                cass_iterator_free(iterator);
+                zval_ptr_dtor(out);
+                return FAILURE;
+            }
+
+            php_driver_tuple_set(tuple, index, &v);
+            zval_ptr_dtor(&v);
+        }
+
+        index++;
+    }
+
+    cass_iterator_free(iterator);
+    return SUCCESS;
+}
+
+static int decode_udt(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                      zval *out)
+{
+    php_driver_user_type_value *user_type_value;
+    CassIterator *iterator;
+    size_t index = 0;
+
+    object_init_ex(out, php_driver_user_type_value_ce);
+    user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(out);
+    ZVAL_COPY(&user_type_value->type, &decoder->type);
+
+    iterator = cass_iterator_fields_from_user_type(value);
+
+    while (cass_iterator_next(iterator) && index < decoder->count)
+    {
+        const CassValue *field = cass_iterator_get_user_type_field_value(iterator);
+
+        if (!cass_value_is_null(field))
+        {
+            const char *name;
+            size_t name_length;
+            zval v;
+
+            if (decoder->sub[index].decode(&decoder->sub[index], field, result, &v) == FAILURE)
+            {
+                cass_iterator_free(iterator);
+                zval_ptr_dtor(out);
+                return FAILURE;
+            }
+
+            cass_iterator_get_user_type_field_name(iterator, &name, &name_length);
+            php_driver_user_type_value_set(user_type_value, name, name_length, &v);
+            zval_ptr_dtor(&v);
+        }
+
+        index++;
     }
 
-    switch (type)
+    cass_iterator_free(iterator);
+    return SUCCESS;
+}
+
+static int decode_blob_string(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                              zval *out)
+{
+    const cass_byte_t *v_bytes;
+    size_t v_bytes_len;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_bytes(value, &v_bytes, &v_bytes_len), FAILURE);
+    ZVAL_STRINGL(out, (const char *)v_bytes, v_bytes_len);
+    return SUCCESS;
+}
+
+static int decode_uuid_string(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                              zval *out)
+{
+    CassUuid uuid;
+    char string[CASS_UUID_STRING_LENGTH];
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_uuid(value, &uuid), FAILURE);
+    cass_uuid_string(uuid, string);
+    ZVAL_STRING(out, string);
+    return SUCCESS;
+}
+
+#if SIZEOF_ZEND_LONG == 8
+static int decode_int64_long(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                             zval *out)
+{
+    cass_int64_t v_int_64;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_int64(value, &v_int_64), FAILURE);
+    ZVAL_LONG(out, v_int_64);
+    return SUCCESS;
+}
+#endif
+
+static int decode_int16_long(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                             zval *out)
+{
+    cass_int16_t v_int_16;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_int16(value, &v_int_16), FAILURE);
+    ZVAL_LONG(out, v_int_16);
+    return SUCCESS;
+}
+
+static int decode_int8_long(const php_driver_decoder *decoder, const CassValue *value, php_driver_ref *result,
+                            zval *out)
+{
+    cass_int8_t v_int_8;
+
+    ASSERT_SUCCESS_VALUE(cass_value_get_int8(value, &v_int_8), FAILURE);
+    ZVAL_LONG(out, v_int_8);
+    return SUCCESS;
+}
+
+#undef DECODE_ASSERT_SUCCESS
+
+static void php_driver_decoder_init(php_driver_decoder *decoder, const CassDataType *data_type, int flags)
+{
+    size_t i;
+
+    decoder->decode = data_type ? decode_null : decode_value;
+    decoder->value_type = data_type ? cass_data_type_type(data_type) : CASS_VALUE_TYPE_UNKNOWN;
+    decoder->count = 0;
+    decoder->sub = NULL;
+    ZVAL_UNDEF(&decoder->type);
+
+    switch (decoder->value_type)
     {
     case CASS_VALUE_TYPE_ASCII:
     case CASS_VALUE_TYPE_TEXT:
     case CASS_VALUE_TYPE_VARCHAR:
-        ASSERT_SUCCESS_BLOCK(cass_value_get_string(value, &v_string, &v_string_len), zval_ptr_dtor(out);
-                             return FAILURE;);
-        ZVAL_STRINGL(out, v_string, v_string_len);
+        decoder->decode = decode_string;
         break;
     case CASS_VALUE_TYPE_INT:
-        ASSERT_SUCCESS_BLOCK(cass_value_get_int32(value, &v_int_32), zval_ptr_dtor(out); return FAILURE;);
-        ZVAL_LONG(out, v_int_32);
+        decoder->decode = decode_int;
         break;
     case CASS_VALUE_TYPE_COUNTER:
     case CASS_VALUE_TYPE_BIGINT:
-        object_init_ex(out, php_driver_bigint_ce);
-        numeric = PHP_DRIVER_GET_NUMERIC(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_int64(value, &numeric->data.bigint.value), zval_ptr_dtor(out);
-                             return FAILURE;);
+        decoder->decode = decode_bigint;
         break;
     case CASS_VALUE_TYPE_SMALL_INT:
-        object_init_ex(out, php_driver_smallint_ce);
-        numeric = PHP_DRIVER_GET_NUMERIC(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_int16(value, &numeric->data.smallint.value), zval_ptr_dtor(out);
-                             return FAILURE;);
+        decoder->decode = decode_smallint;
         break;
     case CASS_VALUE_TYPE_TINY_INT:
-        object_init_ex(out, php_driver_tinyint_ce);
-        numeric = PHP_DRIVER_GET_NUMERIC(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_int8(value, &numeric->data.tinyint.value), zval_ptr_dtor(out);
-                             return FAILURE;);
+        decoder->decode = decode_tinyint;
         break;
     case CASS_VALUE_TYPE_TIMESTAMP:
-        object_init_ex(out, php_scylladb_timestamp_ce);
-        timestamp = Z_SCYLLADB_TIMESTAMP_P(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_int64(value, &timestamp->timestamp), zval_ptr_dtor(out); return FAILURE;);
+        decoder->decode = decode_timestamp;
         break;
     case CASS_VALUE_TYPE_DATE:
-        object_init_ex(out, php_scylladb_date_ce);
-        date = Z_SCYLLADB_DATE_P(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_uint32(value, &date->date), zval_ptr_dtor(out); return FAILURE;);
+        decoder->decode = decode_date;
         break;
     case CASS_VALUE_TYPE_TIME:
-        object_init_ex(out, php_scylladb_time_ce);
-        time = Z_SCYLLADB_TIME_P(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_int64(value, &time->time), zval_ptr_dtor(out); return FAILURE;);
+        decoder->decode = decode_time;
         break;
     case CASS_VALUE_TYPE_BLOB:
-        object_init_ex(out, php_driver_blob_ce);
-        blob = PHP_DRIVER_GET_BLOB(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_bytes(value, &v_bytes, &v_bytes_len), zval_ptr_dtor(out); return FAILURE;);
-        blob->data = static_cast<cass_byte_t *>(emalloc(v_bytes_len * sizeof(cass_byte_t)));
-        blob->size = v_bytes_len;
-        memcpy(blob->data, v_bytes, v_bytes_len);
+        decoder->decode = decode_blob;
         break;
     case CASS_VALUE_TYPE_VARINT:
-        object_init_ex(out, php_driver_varint_ce);
-        numeric = PHP_DRIVER_GET_NUMERIC(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_bytes(value, &v_bytes, &v_bytes_len), zval_ptr_dtor(out); return FAILURE;);
-        import_twos_complement((cass_byte_t *)v_bytes, v_bytes_len, &numeric->data.varint.value);
+        decoder->decode = decode_varint;
         break;
     case CASS_VALUE_TYPE_UUID:
-        object_init_ex(out, php_driver_uuid_ce);
-        uuid = PHP_DRIVER_GET_UUID(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_uuid(value, &uuid->uuid), zval_ptr_dtor(out); return FAILURE;);
-        break;
     case CASS_VALUE_TYPE_TIMEUUID:
-        object_init_ex(out, php_driver_timeuuid_ce);
-        uuid = PHP_DRIVER_GET_UUID(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_uuid(value, &uuid->uuid), zval_ptr_dtor(out); return FAILURE;);
+        decoder->decode = decode_uuid;
         break;
     case CASS_VALUE_TYPE_BOOLEAN:
-        ASSERT_SUCCESS_BLOCK(cass_value_get_bool(value, &v_boolean), zval_ptr_dtor(out); return FAILURE;);
-        if (v_boolean)
-        {
-            ZVAL_TRUE(out);
-        }
-        else
-        {
-            ZVAL_FALSE(out);
-        }
+        decoder->decode = decode_boolean;
         break;
     case CASS_VALUE_TYPE_INET:
-        object_init_ex(out, php_driver_inet_ce);
-        inet = PHP_DRIVER_GET_INET(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_inet(value, &inet->inet), zval_ptr_dtor(out); return FAILURE;);
+        decoder->decode = decode_inet;
         break;
     case CASS_VALUE_TYPE_DECIMAL:
-        object_init_ex(out, php_driver_decimal_ce);
-        numeric = PHP_DRIVER_GET_NUMERIC(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_decimal(value, &v_decimal, &v_decimal_len, &v_decimal_scale),
-                             zval_ptr_dtor(out);
-                             return FAILURE;);
-        import_twos_complement((cass_byte_t *)v_decimal, v_decimal_len, &numeric->data.decimal.value);
-        numeric->data.decimal.scale = v_decimal_scale;
+        decoder->decode = decode_decimal;
         break;
     case CASS_VALUE_TYPE_DURATION:
-        object_init_ex(out, php_driver_duration_ce);
-        duration = PHP_DRIVER_GET_DURATION(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_duration(value, &duration->months, &duration->days, &duration->nanos),
-                             zval_ptr_dtor(out);
-                             return FAILURE;);
+        decoder->decode = decode_duration;
         break;
     case CASS_VALUE_TYPE_DOUBLE:
-        ASSERT_SUCCESS_BLOCK(cass_value_get_double(value, &v_double), zval_ptr_dtor(out); return FAILURE;);
-        ZVAL_DOUBLE(out, v_double);
+        decoder->decode = decode_double;
         break;
     case CASS_VALUE_TYPE_FLOAT:
-        object_init_ex(out, php_driver_float_ce);
-        numeric = PHP_DRIVER_GET_NUMERIC(out);
-        ASSERT_SUCCESS_BLOCK(cass_value_get_float(value, &numeric->data.floating.value), zval_ptr_dtor(out);
-                             return FAILURE;);
+        decoder->decode = decode_float;
         break;
     case CASS_VALUE_TYPE_LIST:
-        object_init_ex(out, php_driver_collection_ce);
-        collection = PHP_DRIVER_GET_COLLECTION(out);
-
-        primary_type = cass_data_type_sub_data_type(data_type, 0);
-        collection->type = php_driver_type_from_data_type(data_type);
-
-        iterator = cass_iterator_from_collection(value);
-
-        while (cass_iterator_next(iterator))
-        {
-            zval v;
-
-            if (php_driver_value(cass_iterator_get_value(iterator), primary_type, &v) == FAILURE)
-            {
-                cass_iterator_free(iterator);
-                zval_ptr_dtor(out);
-                return FAILURE;
-            }
-
-            php_driver_collection_add(collection, &v);
-            zval_ptr_dtor(&v);
-        }
-
-        cass_iterator_free(iterator);
+        decoder->decode = decode_list;
+        decoder->count = 1;
+        break;
+    case CASS_VALUE_TYPE_SET:
+        decoder->decode = decode_set;
+        decoder->count = 1;
         break;
     case CASS_VALUE_TYPE_MAP:
-        object_init_ex(out, php_driver_map_ce);
-        map = PHP_DRIVER_GET_MAP(out);
+        decoder->decode = decode_map;
+        decoder->count = 2;
+        break;
+    case CASS_VALUE_TYPE_TUPLE:
+        decoder->decode = decode_tuple;
+        decoder->count = cass_data_type_sub_type_count(data_type);
+        break;
+    case CASS_VALUE_TYPE_UDT:
+        decoder->decode = decode_udt;
+        decoder->count = cass_data_type_sub_type_count(data_type);
+        break;
+    default:
+        break;
+    }
 
-        primary_type = cass_data_type_sub_data_type(data_type, 0);
-        secondary_type = cass_data_type_sub_data_type(data_type, 1);
-        map->type = php_driver_type_from_data_type(data_type);
+    if ((flags & PHP_DRIVER_DECODE_NATIVE_BLOB) && decoder->value_type == CASS_VALUE_TYPE_BLOB)
+    {
+        decoder->decode = decode_blob_string;
+    }
+    else if ((flags & PHP_DRIVER_DECODE_NATIVE_UUID) &&
+             (decoder->value_type == CASS_VALUE_TYPE_UUID || decoder->value_type == CASS_VALUE_TYPE_TIMEUUID))
+    {
+        decoder->decode = decode_uuid_string;
+    }
+#if SIZEOF_ZEND_LONG == 8
+    else if ((flags & PHP_DRIVER_DECODE_NATIVE_BIGINT) &&
+             (decoder->value_type == CASS_VALUE_TYPE_BIGINT || decoder->value_type == CASS_VALUE_TYPE_COUNTER ||
+              decoder->value_type == CASS_VALUE_TYPE_TIMESTAMP))
+    {
+        /* Timestamps become milliseconds since the epoch */
+        decoder->decode = decode_int64_long;
+    }
+#endif
+    else if ((flags & PHP_DRIVER_DECODE_NATIVE_SMALLINT) && decoder->value_type == CASS_VALUE_TYPE_SMALL_INT)
+    {
+        decoder->decode = decode_int16_long;
+    }
+    else if ((flags & PHP_DRIVER_DECODE_NATIVE_SMALLINT) && decoder->value_type == CASS_VALUE_TYPE_TINY_INT)
+    {
+        decoder->decode = decode_int8_long;
+    }
 
-        iterator = cass_iterator_from_map(value);
+    if (decoder->decode == decode_list || decoder->decode == decode_set || decoder->decode == decode_map ||
+        decoder->decode == decode_tuple || decoder->decode == decode_udt)
+    {
+        /* Nested types resolve their type object and element decoders once per plan */
+        decoder->type = php_driver_type_from_data_type(data_type);
 
-        while (cass_iterator_next(iterator))
+        if (decoder->count > 0)
         {
-            zval k;
-            zval v;
-
-            if (php_driver_value(cass_iterator_get_map_key(iterator), primary_type, &k) == FAILURE ||
-                php_driver_value(cass_iterator_get_map_value(iterator), secondary_type, &v) == FAILURE)
+            decoder->sub = (php_driver_decoder *)ecalloc(decoder->count, sizeof(php_driver_decoder));
+            for (i = 0; i < decoder->count; i++)
             {
-                cass_iterator_free(iterator);
-                zval_ptr_dtor(out);
-                return FAILURE;
+                /* Collection elements stay value objects, their types are validated on insert */
+                php_driver_decoder_init(&decoder->sub[i], cass_data_type_sub_data_type(data_type, i), 0);
             }
-
-            php_driver_map_set(map, &k, &v);
-            zval_ptr_dtor(&k);
-            zval_ptr_dtor(&v);
         }
+    }
+}
 
-        cass_iterator_free(iterator);
-        break;
-    case CASS_VALUE_TYPE_SET:
-        object_init_ex(out, php_driver_set_ce);
-        set = PHP_DRIVER_GET_SET(out);
+static void php_driver_decoder_destroy(php_driver_decoder *decoder)
+{
+    size_t i;
 
-        primary_type = cass_data_type_sub_data_type(data_type, 0);
-        set->type = php_driver_type_from_data_type(data_type);
+    if (decoder->sub)
+    {
+        for (i = 0; i < decoder->count; i++)
+        {
+            php_driver_decoder_destroy(&decoder->sub[i]);
+        }
+        efree(decoder->sub);
+    }
 
-        iterator = cass_iterator_from_collection(value);
+    PHP5TO7_ZVAL_MAYBE_DESTROY(decoder->type);
+}
 
-        while (cass_iterator_next(iterator))
-        {
-            zval v;
+int php_driver_value(const CassValue *value, const CassDataType *data_type, zval *out)
+{
+    php_driver_decoder decoder;
+    int rc;
 
-            if (php_driver_value(cass_iterator_get_value(iterator), primary_type, &v) == FAILURE)
-            {
-                cass_iterator_free(iterator);
-                zval_ptr_dtor(out);
-                return FAILURE;
-            }
+    if (data_type == NULL || cass_value_is_null(value))
+    {
+        ZVAL_NULL(out);
+        return SUCCESS;
+    }
 
-            php_driver_set_add(set, &v);
-            zval_ptr_dtor(&v);
-        }
+    /* Values outside of a result (e.g. schema metadata) have no decoder plan to
+     * reuse, their bytes are copied instead of borrowed.
+     */
+    php_driver_decoder_init(&decoder, data_type, 0);
+    rc = decoder.decode(&decoder, value, NULL, out);
+    php_driver_decoder_destroy(&decoder);
 
-        cass_iterator_free(iterator);
-        break;
-    case CASS_VALUE_TYPE_TUPLE:
-        object_init_ex(out, php_driver_tuple_ce);
-        tuple = PHP_DRIVER_GET_TUPLE(out);
+    return rc;
+}
 
-        tuple->type = php_driver_type_from_data_type(data_type);
+static int php_driver_decoder_names_match(const php_driver_decoder *decoder, const CassDataType *data_type)
+{
+    php_driver_type *type = PHP_DRIVER_GET_TYPE(&decoder->type);
+    const char *name;
+    size_t name_length;
+    zend_string *field;
+    size_t i = 0;
+
+    /* Renaming a type or one of its fields keeps the shape of the data type */
+    cass_data_type_keyspace(data_type, &name, &name_length);
+    if (!type->data.udt.keyspace || strlen(type->data.udt.keyspace) != name_length ||
+        memcmp(type->data.udt.keyspace, name, name_length) != 0)
+    {
+        return 0;
+    }
 
-        iterator = cass_iterator_from_tuple(value);
+    cass_data_type_type_name(data_type, &name, &name_length);
+    if (!type->data.udt.type_name || strlen(type->data.udt.type_name) != name_length ||
+        memcmp(type->data.udt.type_name, name, name_length) != 0)
+    {
+        return 0;
+    }
 
-        index = 0;
-        while (cass_iterator_next(iterator))
+    ZEND_HASH_FOREACH_STR_KEY(&type->data.udt.types, field)
+    {
+        if (!field || cass_data_type_sub_type_name(data_type, i, &name, &name_length) != CASS_OK ||
+            ZSTR_LEN(field) != name_length || memcmp(ZSTR_VAL(field), name, name_length) != 0)
         {
-            const CassValue *value = cass_iterator_get_value(iterator);
+            return 0;
+        }
+        i++;
+    }
+    ZEND_HASH_FOREACH_END();
 
-            if (!cass_value_is_null(value))
-            {
-                zval v;
-
-                primary_type = cass_data_type_sub_data_type(data_type, index);
-                if (php_driver_value(value, primary_type, &v) == FAILURE)
-                {
-                    cass_iterator_free(iterator);
-                    zval_ptr_dtor(out);
-                    return FAILURE;
-                }
-
-                php_driver_tuple_set(tuple, index, &v);
-                zval_ptr_dtor(&v);
-            }
+    return 1;
+}
 
-            index++;
-        }
+static int php_driver_decoder_matches(const php_driver_decoder *decoder, const CassDataType *data_type)
+{
+    size_t i;
 
-        cass_iterator_free(iterator);
-        break;
-    case CASS_VALUE_TYPE_UDT:
-        object_init_ex(out, php_driver_user_type_value_ce);
-        user_type_value = PHP_DRIVER_GET_USER_TYPE_VALUE(out);
+    if (data_type == NULL)
+    {
+        return decoder->value_type == CASS_VALUE_TYPE_UNKNOWN;
+    }
 
-        user_type_value->type = php_driver_type_from_data_type(data_type);
+    if (cass_data_type_type(data_type) != decoder->value_type)
+    {
+        return 0;
+    }
 
-        iterator = cass_iterator_fields_from_user_type(value);
+    if (decoder->value_type == CASS_VALUE_TYPE_UDT && !Z_ISUNDEF(decoder->type) &&
+        !php_driver_decoder_names_match(decoder, data_type))
+    {
+        return 0;
+    }
 
-        index = 0;
-        while (cass_iterator_next(iterator))
-        {
-            const CassValue *value = cass_iterator_get_user_type_field_value(iterator);
+    if (decoder->sub == NULL)
+    {
+        return 1;
+    }
 
-            if (!cass_value_is_null(value))
-            {
-                const char *name;
-                size_t name_length;
-                zval v;
-
-                primary_type = cass_data_type_sub_data_type(data_type, index);
-                if (php_driver_value(value, primary_type, &v) == FAILURE)
-                {
-                    cass_iterator_free(iterator);
-                    zval_ptr_dtor(out);
-                    return FAILURE;
-                }
-
-                cass_iterator_get_user_type_field_name(iterator, &name, &name_length);
-                php_driver_user_type_value_set(user_type_value, name, name_length, &v);
-                zval_ptr_dtor(&v);
-            }
+    if ((decoder->value_type == CASS_VALUE_TYPE_TUPLE || decoder->value_type == CASS_VALUE_TYPE_UDT) &&
+        cass_data_type_sub_type_count(data_type) != decoder->count)
+    {
+        return 0;
+    }
 
-            index++;
+    for (i = 0; i < decoder->count; i++)
+    {
+        if (!php_driver_decoder_matches(&decoder->sub[i], cass_data_type_sub_data_type(data_type, i)))
+        {
+            return 0;
         }
-
-        cass_iterator_free(iterator);
-        break;
-    default:
-        ZVAL_NULL(out);
-        break;
     }
 
-    return SUCCESS;
+    return 1;
 }
 
-int php_driver_get_keyspace_field(const CassKeyspaceMeta *metadata, const char *field_name, zval *out)
+static void free_result_columns(void *data)
 {
-    const CassValue *value;
+    php_driver_result_columns *columns = (php_driver_result_columns *)data;
+    size_t i;
 
-    value = cass_keyspace_meta_field_by_name(metadata, field_name);
-
-    if (value == NULL || cass_value_is_null(value))
+    for (i = 0; i < columns->count; i++)
     {
-
-        ZVAL_NULL(out);
-        return SUCCESS;
+        zend_string_release(columns->names[i]);
+        php_driver_decoder_destroy(&columns->decoders[i]);
     }
 
-    return php_driver_value(value, cass_value_data_type(value), out);
+    if (columns->count > 0)
+    {
+        efree(columns->names);
+        efree(columns->decoders);
+    }
+    efree(columns);
 }
 
-int php_driver_get_table_field(const CassTableMeta *metadata, const char *field_name, zval *out)
+static int php_driver_result_columns_match(const CassResult *result, const php_driver_result_columns *columns)
 {
-    const CassValue *value;
-
-    value = cass_table_meta_field_by_name(metadata, field_name);
+    const char *column_name;
+    size_t column_name_len;
+    size_t i;
 
-    if (value == NULL || cass_value_is_null(value))
+    if (cass_result_column_count(result) != columns->count)
     {
+        return 0;
+    }
 
-        ZVAL_NULL(out);
-        return SUCCESS;
+    for (i = 0; i < columns->count; i++)
+    {
+        cass_result_column_name(result, i, &column_name, &column_name_len);
+        if (ZSTR_LEN(columns->names[i]) != column_name_len ||
+            memcmp(ZSTR_VAL(columns->names[i]), column_name, column_name_len) != 0 ||
+            !php_driver_decoder_matches(&columns->decoders[i], cass_result_column_data_type(result, i)))
+        {
+            return 0;
+        }
     }
 
-    return php_driver_value(value, cass_value_data_type(value), out);
+    return 1;
 }
 
-int php_driver_get_column_field(const CassColumnMeta *metadata, const char *field_name, zval *out)
+php_driver_ref *php_driver_result_columns_get(const CassResult *result, php_driver_ref *cached, int options)
 {
-    const CassValue *value;
+    php_driver_result_columns *columns;
+    const char *column_name;
+    size_t column_name_len;
+    size_t i, j;
+    int flags;
 
-    value = cass_column_meta_field_by_name(metadata, field_name);
+    if (cached && ((const php_driver_result_columns *)cached->data)->options == options &&
+        php_driver_result_columns_match(result, (const php_driver_result_columns *)cached->data))
+    {
+        return php_driver_add_ref(cached);
+    }
 
-    if (value == NULL || cass_value_is_null(value))
+    /* Options sharing a decoder only combine here, each keeps its own bit */
+    flags = 0;
+    if (options & PHP_DRIVER_NATIVE_SCALARS)
+    {
+        flags |= PHP_DRIVER_DECODE_NATIVE_BLOB | PHP_DRIVER_DECODE_NATIVE_UUID | PHP_DRIVER_DECODE_NATIVE_BIGINT;
+    }
+    if (options & PHP_DRIVER_NATIVE_INTEGERS)
     {
+        flags |= PHP_DRIVER_DECODE_NATIVE_BIGINT | PHP_DRIVER_DECODE_NATIVE_SMALLINT;
+    }
 
-        ZVAL_NULL(out);
-        return SUCCESS;
+    columns = (php_driver_result_columns *)ecalloc(1, sizeof(php_driver_result_columns));
+    columns->count = cass_result_column_count(result);
+    columns->options = options;
+    columns->unique = cass_true;
+    columns->numeric = cass_false;
+    columns->names = NULL;
+    columns->decoders = NULL;
+
+    if (columns->count > 0)
+    {
+        columns->names = (zend_string **)ecalloc(columns->count, sizeof(zend_string *));
+        columns->decoders = (php_driver_decoder *)ecalloc(columns->count, sizeof(php_driver_decoder));
     }
 
-    return php_driver_value(value, cass_value_data_type(value), out);
-}
+    for (i = 0; i < columns->count; i++)
+    {
+        cass_result_column_name(result, i, &column_name, &column_name_len);
+        /* Interned keys carry their hash and skip refcounting on every row insert */
+        columns->names[i] = zend_new_interned_string(zend_string_init(column_name, column_name_len, 0));
+        zend_string_hash_val(columns->names[i]);
 
-int php_driver_get_result(const CassResult *result, zval *out)
-{
-    zval rows;
-    zval row;
-    const CassRow *cass_row;
-    const char *column_name;
-    size_t column_name_len;
-    const CassDataType *column_type;
-    const CassValue *column_value;
-    CassIterator *iterator = NULL;
-    size_t columns = -1;
-    char **column_names;
-    unsigned i;
+        if (!columns->numeric)
+        {
+            zend_ulong index;
+            if (ZEND_HANDLE_NUMERIC_STR(ZSTR_VAL(columns->names[i]), ZSTR_LEN(columns->names[i]), index))
+            {
+                columns->numeric = cass_true;
+            }
+        }
+
+        for (j = 0; j < i && columns->unique; j++)
+        {
+            if (zend_string_equals(columns->names[i], columns->names[j]))
+            {
+                columns->unique = cass_false;
+            }
+        }
 
+        php_driver_decoder_init(&columns->decoders[i], cass_result_column_data_type(result, i), flags);
+    }
 
-    array_init(&rows);
+    return php_driver_new_ref(columns, free_result_columns);
+}
 
-    iterator = cass_iterator_from_result(result);
-    columns = cass_result_column_count(result);
+int php_driver_get_row(const php_driver_result_columns *columns, const CassRow *cass_row, php_driver_ref *result,
+                       zval *out)
+{
+    zval row;
+    HashTable *ht;
+    size_t i;
 
-    column_names = (char **)ecalloc(columns, sizeof(char *));
+    array_init_size(&row, columns->count);
+    ht = Z_ARRVAL(row);
+    zend_hash_real_init_mixed(ht);
 
-    while (cass_iterator_next(iterator))
+    for (i = 0; i < columns->count; i++)
     {
+        zval value;
 
-        array_init(&row);
-        cass_row = cass_iterator_get_row(iterator);
+        if (php_driver_decode(&columns->decoders[i], cass_row_get_column(cass_row, i), result, &value) == FAILURE)
+        {
+            zval_ptr_dtor(&row);
+            return FAILURE;
+        }
 
-        for (i = 0; i < columns; i++)
+        /* Duplicate column names (e.g. "SELECT a, a") keep the last value */
+        if (columns->numeric)
+        {
+            zend_symtable_update(ht, columns->names[i], &value);
+        }
+        else if (columns->unique)
+        {
+            _zend_hash_append(ht, columns->names[i], &value);
+        }
+        else
         {
-            zval value;
+            zend_hash_update(ht, columns->names[i], &value);
+        }
+    }
 
-            if (column_names[i] == NULL)
-            {
-                cass_result_column_name(result, i, &column_name, &column_name_len);
-                column_names[i] = estrndup(column_name, column_name_len);
-            }
+    *out = row;
 
-            column_type = cass_result_column_data_type(result, i);
-            column_value = cass_row_get_column(cass_row, i);
+    return SUCCESS;
+}
 
-            if (php_driver_value(column_value, column_type, &value) == FAILURE)
-            {
-                zval_ptr_dtor(&row);
-                zval_ptr_dtor(&rows);
-
-                for (i = 0; i < columns; i++)
-                {
-                    if (column_names[i])
-                    {
-                        efree(column_names[i]);
-                    }
-                }
-
-                efree(column_names);
-                cass_iterator_free(iterator);
+int php_driver_get_column(const php_driver_result_columns *columns, const CassResult *cass_result, size_t index,
+                          php_driver_ref *result, zval *out)
+{
+    zval values;
+    CassIterator *iterator;
+    const php_driver_decoder *decoder = &columns->decoders[index];
 
-                return FAILURE;
-            }
+    array_init_size(&values, cass_result_row_count(cass_result));
+    zend_hash_real_init_packed(Z_ARRVAL(values));
 
-            PHP5TO7_ADD_ASSOC_ZVAL_EX(&row, column_names[i], strlen(column_names[i]) + 1,
-                                      &value);
+    /* Only the requested column is decoded, no per-row arrays are built */
+    iterator = cass_iterator_from_result(cass_result);
+    while (cass_iterator_next(iterator))
+    {
+        zval value;
+
+        if (php_driver_decode(decoder, cass_row_get_column(cass_iterator_get_row(iterator), index), result, &value) ==
+            FAILURE)
+        {
+            zval_ptr_dtor(&values);
+            cass_iterator_free(iterator);
+            return FAILURE;
         }
 
-        add_next_index_zval(&rows, &row);
+        zend_hash_next_index_insert_new(Z_ARRVAL(values), &value);
     }
+    cass_iterator_free(iterator);
+
+    *out = values;
+
+    return SUCCESS;
+}
 
-    for (i = 0; i < columns; i++)
+int php_driver_get_result(const CassResult *result, zval *out)
+{
+    zval rows;
+    CassIterator *iterator = cass_iterator_from_result(result);
+    php_driver_ref *columns = php_driver_result_columns_get(result, NULL, 0);
+
+    array_init_size(&rows, cass_result_row_count(result));
+
+    while (cass_iterator_next(iterator))
     {
-        if (column_names[i] != NULL)
+        zval row;
+
+        if (php_driver_get_row((const php_driver_result_columns *)columns->data, cass_iterator_get_row(iterator),
+                               NULL, &row) == FAILURE)
         {
-            efree(column_names[i]);
+            zval_ptr_dtor(&rows);
+            php_driver_del_ref(&columns);
+            cass_iterator_free(iterator);
+            return FAILURE;
         }
+
+        add_next_index_zval(&rows, &row);
     }
 
-    efree(column_names);
+    php_driver_del_ref(&columns);
     cass_iterator_free(iterator);
 
     *out = rows;
@@ -203,7 +203,60 @@ static inline int php5to7_string_compare(zend_string* s1, zend_string* s2) {
   return memcmp(s1->val, s2->val, s1->len);
 }
 
-zval php_driver_type_from_data_type(const CassDataType* data_type) {
+static void php_driver_type_signature(const CassDataType* data_type, smart_str* signature) {
+  const char* name;
+  size_t name_length;
+  size_t i, count;
+  CassValueType type = cass_data_type_type(data_type);
+
+  /* Names are prefixed with their length so that quoted identifiers can't collide */
+  smart_str_append_long(signature, type);
+
+  switch (type) {
+    case CASS_VALUE_TYPE_CUSTOM:
+      cass_data_type_class_name(data_type, &name, &name_length);
+      smart_str_append_unsigned(signature, name_length);
+      smart_str_appendc(signature, ':');
+      smart_str_appendl(signature, name, name_length);
+      return;
+
+    case CASS_VALUE_TYPE_UDT:
+      cass_data_type_keyspace(data_type, &name, &name_length);
+      smart_str_append_unsigned(signature, name_length);
+      smart_str_appendc(signature, ':');
+      smart_str_appendl(signature, name, name_length);
+      cass_data_type_type_name(data_type, &name, &name_length);
+      smart_str_append_unsigned(signature, name_length);
+      smart_str_appendc(signature, ':');
+      smart_str_appendl(signature, name, name_length);
+      break;
+
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_MAP:
+    case CASS_VALUE_TYPE_SET:
+    case CASS_VALUE_TYPE_TUPLE:
+      break;
+
+    default:
+      return;
+  }
+
+  count = cass_data_type_sub_type_count(data_type);
+  smart_str_appendc(signature, '<');
+  for (i = 0; i < count; ++i) {
+    if (type == CASS_VALUE_TYPE_UDT) {
+      cass_data_type_sub_type_name(data_type, i, &name, &name_length);
+      smart_str_append_unsigned(signature, name_length);
+      smart_str_appendc(signature, ':');
+      smart_str_appendl(signature, name, name_length);
+    }
+    php_driver_type_signature(cass_data_type_sub_data_type(data_type, i), signature);
+    smart_str_appendc(signature, ',');
+  }
+  smart_str_appendc(signature, '>');
+}
+
+static zval php_driver_type_build(const CassDataType* data_type) {
   zval ztype;
   zval key_type;
   zval value_type;
@@ -257,6 +310,48 @@ zval php_driver_type_from_data_type(const CassDataType* data_type) {
   return ztype;
 }
 
+zval php_driver_type_from_data_type(const CassDataType* data_type) {
+  zval ztype;
+  zval* cached;
+  smart_str signature = {0};
+
+  switch (cass_data_type_type(data_type)) {
+    case CASS_VALUE_TYPE_LIST:
+    case CASS_VALUE_TYPE_MAP:
+    case CASS_VALUE_TYPE_SET:
+    case CASS_VALUE_TYPE_TUPLE:
+    case CASS_VALUE_TYPE_UDT:
+      break;
+
+    default:
+      return php_driver_type_build(data_type);
+  }
+
+  /* Types are immutable, so every row of a composite column shares a single
+   * type tree instead of building its own */
+  if (!PHP_DRIVER_G(type_cache)) {
+    ALLOC_HASHTABLE(PHP_DRIVER_G(type_cache));
+    zend_hash_init(PHP_DRIVER_G(type_cache), 0, NULL, ZVAL_PTR_DTOR, 0);
+  }
+
+  php_driver_type_signature(data_type, &signature);
+  smart_str_0(&signature);
+
+  cached = zend_hash_find(PHP_DRIVER_G(type_cache), signature.s);
+  if (cached) {
+    ZVAL_COPY(&ztype, cached);
+  } else {
+    ztype = php_driver_type_build(data_type);
+    if (!Z_ISUNDEF(ztype)) {
+      Z_ADDREF(ztype);
+      zend_hash_add_new(PHP_DRIVER_G(type_cache), signature.s, &ztype);
+    }
+  }
+
+  smart_str_free(&signature);
+  return ztype;
+}
+
 int php_driver_type_validate(zval* object, const char* object_name) {
   if (!instanceof_function(Z_OBJCE_P(object), php_driver_type_scalar_ce) &&
       !instanceof_function(Z_OBJCE_P(object), php_driver_type_collection_ce) &&
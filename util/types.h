@@ -20,7 +20,9 @@
 #include <php_driver.h>
 #include <php_driver_types.h>
 
-
+/* Composite types are interned for the rest of the request, the returned
+ * type is shared and must not be modified.
+ */
 zval php_driver_type_from_data_type(const CassDataType* data_type);
 
 int php_driver_type_validate(zval* object, const char* object_name);